@@ -0,0 +1,81 @@
+#pragma once
+#include <GL/glew.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+// Uploads GL resources (texture and buffer data, new objects) on a thread of its own,
+// through a second context that shares objects with the rendering one. Each job's GL
+// work runs on the loader thread and is followed by a fence; the GL thread polls the
+// fences without blocking and runs the job's completion callback once its fence has
+// signaled, so nothing is drawn from before the GPU has it. The other direction is
+// fenced too: submitting fences the GL thread's commands so far, and the loader's GPU
+// work waits for them, so objects created just before a job are complete for it. Sync
+// objects are shared between the contexts like textures are, but the rendering context
+// must bind an object again after its job completed to be sure to see the new contents.
+//
+// Without a loader thread (no shared context) every job runs right away on the
+// calling GL thread, so callers need not care which mode is active.
+class AssetLoader {
+public:
+    using Ticket = unsigned long long; // 0 is never issued
+
+    AssetLoader();
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Start the loader thread. makeCurrent binds the shared context on the calling
+    // thread (false if it cannot), release unbinds it; both are called on the loader.
+    bool start(std::function<bool()> makeCurrent, std::function<void()> release);
+    void stop(); // GL thread: complete every job, then end the thread
+    bool isThreaded() const { return loader.joinable(); }
+
+    // Queue GL work for the loader context; ready runs on the GL thread once the work is
+    // complete on the GPU. Context state the work changes stays on the loader context.
+    Ticket submit(std::function<void()> upload, std::function<void()> ready);
+
+    void poll();              // GL thread: complete every finished job, in order, without blocking
+    void wait(Ticket ticket); // GL thread: block until the job (and every earlier one) completed
+    void finish();            // GL thread: wait for every job
+
+    int getPending() const { return pending; } // Jobs not completed yet (any thread)
+    unsigned int getUploads() const { return uploads; }
+    unsigned int getBlockingWaits() const { return blockingWaits; }
+
+private:
+    struct Job {
+        Ticket ticket = 0;
+        std::function<void()> upload;
+        std::function<void()> ready;
+        GLsync submitted = nullptr; // GL thread commands before the job
+        GLsync fence = nullptr;     // Set by the loader after the upload
+    };
+
+    // Shared with the loader thread
+    std::mutex mutex;
+    std::condition_variable wake;     // Jobs queued, or stopping
+    std::condition_variable uploaded; // A job was fenced
+    std::deque<Job> queued;           // Waiting for the loader
+    std::deque<Job> fenced;           // Uploaded, waiting for the GL thread
+    bool stopping;
+    std::thread loader;
+    std::function<bool()> makeCurrent;
+    std::function<void()> release;
+
+    // GL thread only
+    Ticket nextTicket;
+    Ticket completedTicket; // Jobs complete in ticket order
+    unsigned int uploads;
+    unsigned int blockingWaits;
+
+    std::atomic<int> pending;
+
+    void complete(Job& job);
+    void loaderLoop(std::promise<bool>* started);
+};
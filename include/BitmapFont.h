@@ -0,0 +1,36 @@
+#pragma once
+
+// Pixel-art HUD fonts (the fallback when the TrueType font is unavailable),
+// defined entirely as compile-time data. The glyph shapes are constexpr
+// functions evaluated during compilation and laid out, already flipped to
+// OpenGL's bottom-row-first order, into one coverage atlas per font: 16
+// columns of ASCII cells, each with a one-texel transparent gutter, followed
+// by a solid cell for panels. At runtime the atlas is uploaded as-is and a
+// glyph is a cell lookup. BitmapFont.cpp statically asserts that every
+// printable ASCII character has its own glyph rather than the block drawn
+// for unknown characters.
+class BitmapFont {
+public:
+    static constexpr int GLYPH_COUNT = 128;        // ASCII
+    static constexpr int SOLID_CELL = GLYPH_COUNT; // Fully covered, for panels
+    static constexpr int COLUMNS = 16;
+    static constexpr int ROWS = GLYPH_COUNT / COLUMNS + 1;
+    static constexpr int BASIC_SIZE = 12; // Font of Renderer::renderText
+    static constexpr int HUD_SIZE = 16;   // Font of Renderer::renderEnhancedText
+
+    // Atlas layout for a glyph size; origins are the bottom-left texel of a cell's glyph area
+    static constexpr int cellSize(int glyphSize) { return glyphSize + 2; }
+    static constexpr int atlasWidth(int glyphSize) { return COLUMNS * cellSize(glyphSize); }
+    static constexpr int atlasHeight(int glyphSize) { return ROWS * cellSize(glyphSize); }
+    static constexpr int cellOriginX(int glyphSize, int cell) { return (cell % COLUMNS) * cellSize(glyphSize) + 1; }
+    static constexpr int cellOriginY(int glyphSize, int cell) { return (cell / COLUMNS) * cellSize(glyphSize) + 1; }
+
+    // Coverage (0 or 255) of every texel, bottom row first
+    template <int Size>
+    struct Atlas {
+        unsigned char coverage[COLUMNS * (Size + 2) * ROWS * (Size + 2)];
+    };
+
+    static const Atlas<BASIC_SIZE> BASIC;
+    static const Atlas<HUD_SIZE> HUD;
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include "FrameSnapshot.h"
+#include "Renderer.h"
+#include <vector>
+
+// Draws FrameSnapshots with a Renderer on the thread that owns the GL context.
+// Builds the card atlas for each deal, makes sure every face on screen is in it,
+// and re-renders a retained layer only when what it shows has changed.
+class BoardView {
+private:
+    unsigned int deal;
+    bool dealReady; // The atlas holds the layers of deal
+    std::vector<CardInstance> drawnResting;
+    std::vector<CardInstance> drawnAnimated;
+    std::vector<HudLine> drawnHud;
+    
+public:
+    BoardView();
+    
+    // Camera comes from Renderer::beginFrame; only changed layers are redrawn
+    void render(const FrameSnapshot& snapshot, Renderer* renderer);
+    
+    // Atlas layers the instances show the front of, each once. Cards reveal their front
+    // from the flip's midpoint on, so these faces are finished before the frame is drawn.
+    static std::vector<int> getShownFaces(const std::vector<CardInstance>& resting,
+                                          const std::vector<CardInstance>& animated);
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include "GameManager.h"
+#include "FrameSnapshot.h"
+#include "Renderer.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+// Many independent games tiled on one screen, e.g. for tournament displays. Every
+// board keeps its own world coordinates; the wall only shifts each board into its
+// tile, so all boards share one camera, one card atlas (every board's faces) and one
+// instanced draw per layer, however many boards there are.
+class BoardWall {
+private:
+    std::vector<std::unique_ptr<GameManager>> boards;
+    int numPairs;
+    int columns;
+    int rows;
+
+    // Published every frame; the vectors keep their capacity
+    std::vector<FrameSnapshot> snapshots;
+
+    // Atlas layers of the whole wall, rebuilt when any board is dealt again
+    std::vector<unsigned int> atlasDeals;       // Deal each board had when the layers were assigned
+    std::vector<std::vector<int>> wallLayers;   // Per board: its own atlas layer -> wall atlas layer
+    std::vector<std::pair<int, int>> wallFaces; // Every board's faces, board after board
+    bool atlasBuilt;
+
+    // The whole wall, drawn into each retained layer
+    std::vector<CardInstance> resting;
+    std::vector<CardInstance> animated;
+    std::vector<HudLine> hud; // One line per board
+
+    // What each board's tile of the layers shows: a board that changes only has its
+    // tile redrawn, scissored, so one flip does not repaint the other boards
+    std::vector<std::vector<CardInstance>> drawnResting;
+    std::vector<std::vector<CardInstance>> drawnAnimated;
+    std::vector<HudLine> drawnHud;
+
+    glm::vec2 getHalfExtent(int width, int height) const; // Of the wall projection, in wall units
+    bool assignWallLayers(); // True if any board was dealt since the last call
+    void buildHud(int width, int height);
+    void markTileDirty(Renderer* renderer, Renderer::Layer layer, int board, int width, int height) const;
+
+public:
+    // One tile per board: the 4-column card grid plus a margin, and a strip on top for its HUD line
+    static constexpr float TILE_WIDTH = 400.0f;
+    static constexpr float TILE_HEIGHT = 600.0f;
+    static constexpr float BOARD_OFFSET_Y = -20.0f; // Cards sit below the HUD strip
+
+    BoardWall();
+
+    // Deal boardCount games and choose the grid that shows them largest at this window size
+    void initialize(int boardCount, int pairs, int width, int height);
+    void reset();
+    void update(float deltaTime);
+
+    // Wall coordinates: the world space of getProjection
+    bool handleMouseClick(float x, float y); // True if the click started a flip
+    void handleMouseMove(float x, float y);
+    glm::vec2 screenToWall(glm::vec2 screenPos, int width, int height) const;
+    glm::mat4 getProjection(int width, int height) const; // Whole wall, letterboxed to the window
+
+    int getBoardCount() const { return static_cast<int>(boards.size()); }
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+    GameManager& getBoard(int board) { return *boards[board]; }
+    glm::vec2 getBoardOrigin(int board) const; // Wall position of the board's (0, 0)
+    int boardAt(float x, float y) const;       // -1 outside every tile
+    int getBoardsWon() const;
+
+    bool needsContinuousFrames() const;
+    float getSecondsUntilClockTick() const;
+
+    // Draw every board; the HUD lines are sized to fit the tiles at this window size
+    void render(Renderer* renderer, int width, int height);
+};
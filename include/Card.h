@@ -4,9 +4,22 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
+#include <functional>
 
-// Global VAO for rendering (defined in Renderer.cpp)
-extern GLuint g_cardVAO;
+struct PatternColor {
+    unsigned char r, g, b;
+};
+
+// Per-instance data for the board's single instanced draw (see card_vertex.glsl)
+struct CardInstance {
+    float x, y;       // World position of the card center
+    float angleY;     // Flip angle in degrees
+    GLint layer;      // Atlas layer to sample: the face or the shared back
+    GLint showFront;  // Which side the procedural shader draws
+    GLint rank;
+    GLint suit;
+    unsigned char patternColor[4]; // RGB of the face pattern, alpha unused
+};
 
 enum class CardState {
     FACE_DOWN,
@@ -28,23 +41,39 @@ private:
     float flipProgress;
     float flipSpeed;
     bool isFlipping;
-    GLuint frontTexture;
-    GLuint backTexture;
-    
-    // Helper function to create detailed card textures
-    GLuint createDetailedCardTexture(int rank, int suit, bool isFront);
+    int faceLayer; // Layer of this card's face in the renderer's card atlas
+    std::function<void(int layer)> faceRequest; // Starts generating faceLayer in the background
 
 public:
+    static constexpr float WIDTH = 80.0f;   // World-space card size
+    static constexpr float HEIGHT = 120.0f;
+    static constexpr int TEXTURE_SIZE = 128; // Card textures are TEXTURE_SIZE x TEXTURE_SIZE RGBA
+    static constexpr int TEXTURE_VERSION = 1; // Bump whenever generated pixels change (invalidates disk caches)
+    
+    // Generate the RGBA pixels for a card face (or the shared back when isFront is false).
+    // This is the scalar reference; CardRasterizer produces identical pixels faster.
+    static std::vector<unsigned char> createDetailedCardPixels(int rank, int suit, bool isFront);
+    
+    // The 16 front pattern families: base color and per-pixel coverage around the center
+    static PatternColor patternColor(int pattern);
+    static bool patternContains(int pattern, int dx, int dy, int dist);
+    
     Card(int cardId, int cardRank, int cardSuit);
     ~Card();
     
     void update(float deltaTime);
-    void draw(GLuint shaderProgram, glm::mat4 viewMatrix, glm::mat4 projMatrix);
+    CardInstance getInstance() const; // What Renderer::drawCards needs to draw this card
     void onClick();
     void startFlip();
     void setPosition(float x, float y);
     void setTargetPosition(float x, float y);
     void setState(CardState newState);
+    void setFaceLayer(int layer) { faceLayer = layer; }
+    
+    // Faces are generated lazily: prepareFace() starts it in the background (hover,
+    // proximity, click); BoardView finishes it before the first frame showing the front
+    void setFaceRequest(std::function<void(int layer)> request) { faceRequest = std::move(request); }
+    void prepareFace();
     
     // Getters
     int getId() const { return id; }
@@ -53,6 +82,7 @@ public:
     CardState getState() const { return state; }
     glm::vec2 getPosition() const { return position; }
     bool getIsFlipping() const { return isFlipping; }
+    int getFaceLayer() const { return faceLayer; }
     
     // Check if point is inside card bounds
     bool contains(float x, float y) const;
@@ -0,0 +1,25 @@
+#pragma once
+#include <vector>
+
+// Fast card texture generator. Each of the 16 front patterns has its own
+// template-specialized row kernel, picked once per texture, that evaluates
+// whole rows in SIMD lanes (AVX2 when compiled with -mavx2, otherwise SSE2,
+// with a scalar fallback) and writes RGBA with vector stores.
+// Output is pixel-identical to Card::createDetailedCardPixels.
+class CardRasterizer {
+public:
+    // Drop-in replacement for Card::createDetailedCardPixels
+    static std::vector<unsigned char> rasterize(int rank, int suit, bool isFront);
+
+    // Write a TEXTURE_SIZE x TEXTURE_SIZE RGBA front face into rgba
+    static void rasterizeFront(int rank, int suit, unsigned char* rgba);
+
+    // Convert a finished RGBA face to one palette index per pixel (indices must hold
+    // TEXTURE_SIZE^2 bytes, palette PALETTE_SIZE RGBA entries). Faces use far fewer than
+    // 256 colors; returns the number of palette entries used.
+    static constexpr int PALETTE_SIZE = 256;
+    static int palettize(const unsigned char* rgba, unsigned char* indices, unsigned char* palette);
+
+    // "AVX2", "SSE2" or "scalar", depending on how this file was compiled
+    static const char* getInstructionSet();
+};
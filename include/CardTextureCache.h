@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class WorkerPool;
+
+// Versioned on-disk cache of every finished card texture (the back plus all
+// 52 fronts), memory-mapped read-only so layers can be handed straight to
+// glTexSubImage3D without an intermediate copy.
+//
+// File layout: a fixed header followed by LAYER_COUNT tightly packed
+// TEXTURE_SIZE x TEXTURE_SIZE RGBA layers. Layer 0 is the back, front
+// (rank, suit) lives at 1 + suit * 13 + (rank - 1).
+class CardTextureCache {
+private:
+    const unsigned char* mapped; // Whole file, or nullptr when nothing is open
+    size_t mappedSize;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+public:
+    static constexpr int LAYER_COUNT = 1 + 52;
+
+    CardTextureCache();
+    ~CardTextureCache();
+
+    CardTextureCache(const CardTextureCache&) = delete;
+    CardTextureCache& operator=(const CardTextureCache&) = delete;
+
+    // Map an existing cache; fails if it is missing, truncated, or was written
+    // by a different generator version or texture size
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapped != nullptr; }
+
+    // Generate every layer with CardRasterizer on the pool and write a fresh
+    // cache file under a temporary name, then rename it into place
+    static bool build(const std::string& path, WorkerPool& pool);
+
+    // Pointers into the mapping; valid until close()
+    const unsigned char* getBack() const;
+    const unsigned char* getFront(int rank, int suit) const;
+
+    static int layerIndex(int rank, int suit) { return 1 + suit * 13 + (rank - 1); }
+};
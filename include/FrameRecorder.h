@@ -0,0 +1,89 @@
+#pragma once
+#include <GL/glew.h>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Records the rendered frames to a Y4M (YUV4MPEG2, 4:2:0) video without stalling
+// the frame. Each capture starts an asynchronous glReadPixels into the next of
+// RING_SIZE pixel buffer objects and fences it; the buffer is mapped only once its
+// fence has signaled, normally frames later, and the pixels are handed to a writer
+// thread that converts them to YUV and streams them to disk.
+//
+// Frames carry the time they were drawn. The video runs at a constant rate, so the
+// writer repeats the previous frame across idle gaps and skips frames drawn faster
+// than the video rate, keeping the recording in real time. If the writer falls
+// more than MAX_QUEUED frames behind, new frames are dropped rather than waited for.
+class FrameRecorder {
+public:
+    static constexpr int RING_SIZE = 3;   // Readbacks in flight
+    static constexpr int MAX_QUEUED = 8;  // Frames waiting for the writer
+
+    FrameRecorder();
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    // Open the file and create the buffers (GL thread); frames are width x height at fps
+    bool start(const std::string& path, int width, int height, int fps);
+    bool isRecording() const { return writer.joinable(); }
+
+    // Read back the finished frame in framebuffer (0: the window's back buffer),
+    // drawn at seconds since any fixed origin. Call after the frame's last draw.
+    void capture(GLuint framebuffer, double seconds);
+
+    // Collect the outstanding readbacks, write everything and close the file (GL thread)
+    void finish();
+
+    // RGBA rows, bottom row first as GL reads them, to Y, Cb and Cr planes (BT.601,
+    // studio range; chroma averaged over 2x2 blocks) with the top row first
+    static void convertToI420(const unsigned char* rgba, int width, int height, std::vector<unsigned char>& planes);
+
+private:
+    struct Slot {
+        GLuint buffer = 0;
+        GLsync fence = nullptr; // Set while a readback is outstanding
+        double seconds = 0.0;
+    };
+    struct Frame {
+        std::vector<unsigned char> rgba;
+        double seconds = 0.0;
+    };
+
+    Slot slots[RING_SIZE];
+    int nextSlot; // Oldest readback, and the slot the next capture uses
+    int width;
+    int height;
+    int fps;
+    std::string path;
+
+    // Shared with the writer thread
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Frame> queue;
+    std::vector<std::vector<unsigned char>> spareBuffers; // Returned by the writer for reuse
+    bool stopping;
+
+    // Writer thread only
+    std::thread writer;
+    std::ofstream file;
+    std::vector<unsigned char> planes;
+    bool haveFrame;
+    double firstSeconds;
+    long long videoFrames; // Frames in the file so far
+    unsigned int skipped;  // Drawn faster than the video rate
+
+    // GL thread only
+    unsigned int captured;
+    unsigned int dropped; // Writer too far behind
+    unsigned int stalls;  // Captures that had to wait for a readback
+
+    bool collect(Slot& slot, bool wait);
+    void writerLoop();
+    void writeFrame(const Frame& frame);
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include "Card.h"
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+// One line of HUD text in overlay coordinates
+struct HudLine {
+    std::string text;
+    float x, y, scale;
+    bool operator==(const HudLine& other) const {
+        return text == other.text && x == other.x && y == other.y && scale == other.scale;
+    }
+};
+
+// Everything drawn for one simulation tick, published by GameManager::publish and drawn
+// by BoardView. Once published it is immutable; the simulation refills a different
+// snapshot next tick (the vectors keep their capacity when a snapshot is reused).
+struct FrameSnapshot {
+    unsigned long long tick = 0; // Simulation updates so far
+    unsigned int deal = 0;       // Changes whenever the deck is dealt: the atlas is rebuilt
+    std::vector<std::pair<int, int>> faces; // (rank, suit) of every card of the deal
+    std::vector<CardInstance> resting;      // Board layer
+    std::vector<CardInstance> animated;     // Animation layer: cards mid-flip
+    std::vector<HudLine> hud;
+    std::vector<int> requestedFaces; // Atlas layers to generate ahead, cumulative per deal
+    bool continuousFrames = false;   // Something moves: keep drawing
+    
+    // Click-to-flip latency: a flip started by input, and when that input happened
+    unsigned long long flipSerial = 0;
+    std::chrono::steady_clock::time_point flipInputTime;
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include "Deck.h"
 #include "Renderer.h"
+#include "FrameSnapshot.h"
+#include "BoardView.h"
 #include <chrono>
 
 enum class GameState {
@@ -37,9 +39,17 @@ private:
     float matchDelay;
     bool gameWon;
     bool animating; // Guard for preventing clicks during animations
+    unsigned int deal;          // Deals so far; each needs its own card atlas
+    unsigned long long ticks;   // update() calls so far
+    std::vector<int> requestedFaces; // Face layers cards asked for this deal, in order
+    void buildHud(std::vector<HudLine>& lines) const;
     
     std::chrono::high_resolution_clock::time_point gameStartTime;
     
+    // Single-threaded drawing: the last snapshot and what its layers show
+    FrameSnapshot frame;
+    BoardView view;
+    
 public:
     GameManager();
     ~GameManager();
@@ -47,7 +57,13 @@ public:
     void initialize(int numPairs);
     void update(float deltaTime);
     void handleCardClick(Card* clickedCard);
-    void render(GLuint shaderProgram, glm::mat4 viewMatrix, glm::mat4 projMatrix, Renderer* renderer);
+    
+    // Copy everything the renderer needs from the current state. The simulation never
+    // touches GL, so it can run on its own thread and hand snapshots to the renderer.
+    void publish(FrameSnapshot& snapshot) const;
+    
+    // Publish and draw right away on the calling (GL) thread
+    void render(Renderer* renderer);
     
     // State management
     void setState(GameState newState);
@@ -56,10 +72,14 @@ public:
     void checkWinCondition();
     
     // Input handling
-    void handleMouseClick(float x, float y);
+    bool handleMouseClick(float x, float y); // True if the click started a flip
+    void handleMouseMove(float x, float y); // Prefetches faces of cards near the pointer
+    
+    static constexpr float FACE_PREFETCH_RADIUS = 120.0f; // World units around the pointer
     
     // Getters
     GameState getCurrentState() const { return currentState; }
+    const Deck& getDeck() const { return deck; }
     int getScore() const { return score; }
     int getMoves() const { return moves; }
     int getTotalMatches() const { return totalMatches; }
@@ -68,6 +88,11 @@ public:
     bool isAnimating() const { return animating; }
     float getElapsedTime() const;
     
+    // Frame pacing: while a card moves or a state timer runs the game needs continuous
+    // frames; otherwise nothing changes until input or the HUD clock's next second
+    bool needsContinuousFrames() const;
+    float getSecondsUntilClockTick() const;
+    
     // Scoring
     struct ScoreBreakdown {
         int base;
@@ -0,0 +1,69 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+// GPU time per render pass from GL_TIME_ELAPSED queries. Every pass of a frame
+// gets its own query; results are read FRAMES_IN_FLIGHT frames later, when the
+// GPU has long finished them, so reading never stalls. A result that is still
+// not available by then is dropped rather than waited for.
+class GpuProfiler {
+public:
+    static constexpr int MAX_PASSES = 8;
+    static constexpr int FRAMES_IN_FLIGHT = 4; // Readback latency in frames
+    static constexpr int HISTORY = 120;        // Samples kept per pass
+
+    // Rolling window over the last HISTORY samples of one pass (no GL)
+    class RollingStats {
+    private:
+        float samples[HISTORY] = {};
+        int count = 0;
+        int next = 0;
+        float last = 0.0f;
+
+    public:
+        void add(float milliseconds);
+        void clear() { count = 0; next = 0; last = 0.0f; }
+        int getCount() const { return count; }
+        float getLast() const { return last; }
+        float getAverage() const;
+        float getMax() const;
+    };
+
+    GpuProfiler();
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // Create the query objects for up to MAX_PASSES named passes
+    bool initialize(const std::vector<std::string>& passNames);
+    void release();
+    bool isInitialized() const { return !names.empty(); }
+
+    // Collect the results of the frame issued FRAMES_IN_FLIGHT frames ago and reuse its queries
+    void beginFrame();
+
+    // Passes must not nest (one GL_TIME_ELAPSED query can be active at a time);
+    // a pass is timed at most once per frame
+    void beginPass(int pass);
+    void endPass();
+
+    int getPassCount() const { return static_cast<int>(names.size()); }
+    const std::string& getPassName(int pass) const { return names[pass]; }
+    const RollingStats& getStats(int pass) const { return stats[pass]; }
+    unsigned int getDroppedResults() const { return droppedResults; }
+    void clearStats();
+
+private:
+    struct FrameQueries {
+        GLuint queries[MAX_PASSES] = {};
+        bool issued[MAX_PASSES] = {};
+    };
+    FrameQueries frames[FRAMES_IN_FLIGHT];
+    int currentFrame;
+    int activePass; // -1 when no query is running
+    std::vector<std::string> names;
+    RollingStats stats[MAX_PASSES];
+    unsigned int droppedResults;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+
+// Offscreen OpenGL 3.3 core context for machines without a display (CI, batch
+// benchmarking). On Linux it uses EGL on Mesa's surfaceless platform, which
+// runs on llvmpipe with no GPU or X server; frames are rendered into a
+// framebuffer object owned by the context (see Renderer::setTargetFramebuffer).
+// Builds without EGL (HAVE_EGL undefined) get a create() that always fails.
+class HeadlessContext {
+private:
+    void* display; // EGLDisplay
+    void* context; // EGLContext
+    void* sharedContext; // EGLContext sharing objects with context, for a loader thread
+    GLuint framebuffer;
+    GLuint colorBuffer;
+    GLuint depthBuffer;
+    int width;
+    int height;
+
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    // Create the context, make it current and allocate a width x height RGBA8 + depth target
+    bool create(int width, int height);
+    void destroy();
+
+    // A second context sharing this one's objects, for a thread of its own (see
+    // AssetLoader): create it here, then bind and unbind it on that thread
+    bool createSharedContext();
+    bool makeSharedContextCurrent();
+    void releaseSharedContext();
+
+    GLuint getFramebuffer() const { return framebuffer; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Read the target back and write it as a binary PPM (P6), top row first
+    bool saveFrame(const std::string& path) const;
+};
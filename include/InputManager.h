@@ -2,12 +2,16 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
+#include <chrono>
 
 class InputManager {
 private:
     GLFWwindow* window;
     bool mousePressed;
+    bool mouseJustPressed; // Latched until update(), like mouseReleased
     bool mouseReleased;
+    std::chrono::steady_clock::time_point pressTime;   // When the app received the last press
+    std::chrono::steady_clock::time_point releaseTime; // ... and the last release
     glm::vec2 mousePosition;
     glm::vec2 lastMousePosition;
     
@@ -20,12 +24,16 @@ public:
     
     // Mouse input
     bool isMousePressed() const { return mousePressed; }
+    bool isMouseJustPressed() const { return mouseJustPressed; }
     bool isMouseReleased() const { return mouseReleased; }
+    std::chrono::steady_clock::time_point getPressTime() const { return pressTime; }
+    std::chrono::steady_clock::time_point getReleaseTime() const { return releaseTime; }
     glm::vec2 getMousePosition() const { return mousePosition; }
     glm::vec2 getLastMousePosition() const { return lastMousePosition; }
     
-    // Convert screen coordinates to world coordinates
-    glm::vec2 screenToWorld(glm::vec2 screenPos, int windowWidth, int windowHeight);
+    // Convert window coordinates (origin top left, window size in screen coordinates)
+    // to world coordinates through the orthographic projection the scene is drawn with
+    static glm::vec2 screenToWorld(glm::vec2 screenPos, const glm::mat4& projection, int windowWidth, int windowHeight);
     
     // Keyboard input
     bool isKeyPressed(int key);
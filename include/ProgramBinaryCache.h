@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Linked GL programs from glGetProgramBinary, kept in one file so later runs can
+// skip compiling and linking. Entries are keyed by a hash of the shader sources;
+// the whole file is keyed by the driver (vendor, renderer and version strings),
+// since binaries are only valid for the driver that produced them.
+//
+// File layout: a fixed header, then per entry the source key, binary format,
+// byte count and the binary itself.
+class ProgramBinaryCache {
+public:
+    struct Binary {
+        uint32_t format = 0; // GLenum from glGetProgramBinary
+        std::vector<unsigned char> data;
+    };
+    
+private:
+    std::unordered_map<uint64_t, Binary> binaries;
+    uint64_t driverKey;
+    bool dirty; // Entries changed since load
+    
+public:
+    static constexpr uint32_t VERSION = 1;
+    
+    ProgramBinaryCache();
+    
+    // 64-bit FNV-1a; chain calls through seed to hash several strings
+    static uint64_t hash(const std::string& text, uint64_t seed = 14695981039346656037ull);
+    
+    // Read a cache written for the same driver. Returns false (leaving the cache
+    // empty but keyed to driver) if it is missing, damaged or from another driver.
+    bool load(const std::string& path, uint64_t driver);
+    
+    // Write every entry under a temporary name, then rename it into place
+    bool save(const std::string& path);
+    
+    const Binary* find(uint64_t sourceKey) const;
+    void store(uint64_t sourceKey, Binary binary);
+    void remove(uint64_t sourceKey); // A binary the driver rejected
+    
+    size_t size() const { return binaries.size(); }
+    bool isDirty() const { return dirty; }
+};
@@ -3,20 +3,218 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <string>
+#include <vector>
+#include <utility>
+#include <future>
+#include <map>
+#include <unordered_map>
+#include <deque>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include "WorkerPool.h"
+#include "CardTextureCache.h"
+#include "Card.h"
+#include "SdfFont.h"
+#include "GpuProfiler.h"
+#include "StreamBuffer.h"
+#include "ProgramBinaryCache.h"
+#include "ResolutionScaler.h"
+#include "AssetLoader.h"
 
-// Simple FontGlyph (future expansion if real TTF rasterization added)
-struct FontGlyph {
-    GLuint texture = 0;
-    int width = 0;
-    int height = 0;
-    int advance = 0;
+// GL work issued by the Renderer in one frame (reset by beginFrame)
+struct GLCallStats {
+    unsigned int drawCalls = 0;
+    unsigned int programBinds = 0;
+    unsigned int uniformUploads = 0;
+    unsigned int textureUploads = 0;
+    unsigned int bufferUploads = 0;
+    unsigned int layersRedrawn = 0; // Retained layers re-rendered (the rest were composited from cache)
 };
 
 class Renderer {
 private:
     GLuint VAO, VBO, EBO;
+    GLuint cardVAO;        // Quad plus per-instance CardInstance attributes (from streamBuffer)
+    GLuint cameraUBO;      // "Camera" uniform block shared by every program
     GLuint cardShaderProgram;
     GLuint textShaderProgram;
+    GLuint cardAtlas;      // GL_TEXTURE_2D_ARRAY shared by every card
+    GLuint cardPalette;    // Indexed mode: 256 x layers RGBA palette, one row per atlas layer
+    int cardAtlasLayers;   // Allocated layer count (back + unique faces)
+    bool cardAtlasIndexed; // Format of the allocated atlas: R8 indices or RGBA8
+    WorkerPool texturePool; // Generates card pixels off the GL thread
+    CardTextureCache cardCache; // Memory-mapped finished textures, uploaded without copies
+    bool proceduralFaces;   // Draw faces in card_fragment.glsl instead of sampling the atlas
+    bool indexedFaces;      // Build the atlas as R8 palette indices (a quarter of RGBA8)
+    
+    // Per-layer state of the lazily filled atlas; index 0 is the back
+    struct AtlasLayer {
+        int rank = 0;
+        int suit = 0;
+        bool isFront = true;
+        bool uploaded = false;
+        const unsigned char* cached = nullptr; // RGBA source: cache mapping or pixels
+        std::vector<unsigned char> pixels;
+        std::vector<unsigned char> indices;
+        std::vector<unsigned char> palette;
+        std::future<void> ready; // Valid while a worker job is outstanding
+        AssetLoader::Ticket upload = 0; // Set while the loader thread uploads it
+    };
+    std::vector<AtlasLayer> atlasLayers;
+    
+    // Texture uploads off the GL thread (see AssetLoader); immediate until started
+    AssetLoader assetLoader;
+    bool loadingOverlay;
+    std::atomic<bool> loadingAssets; // Read by the simulation thread to keep frames coming
+    void queueLoadingOverlay();
+    
+    // Uniform locations per program, resolved once after linking
+    std::map<GLuint, std::unordered_map<std::string, GLint>> programUniforms;
+    void reflectProgram(GLuint program);
+    
+    // Hot locations, plus the last value uploaded for per-board mode flags
+    struct CardUniforms {
+        GLint proceduralFaces = -1;
+        GLint indexedFaces = -1;
+        int proceduralValue = -1;
+        int indexedValue = -1;
+    } cardUniforms;
+    
+    // HUD fonts, rasterized once at initialize into one texture each: a 16-column grid
+    // of ASCII cells plus a solid cell for panels. Text only ever samples sub-rectangles.
+    static constexpr int FONT_GLYPHS = 128;
+    struct FontAtlas {
+        GLuint texture = 0;
+        int glyphSize = 0;
+        glm::vec4 glyphRect[FONT_GLYPHS]; // Atlas (u0, v0, u1, v1) of each character cell
+        glm::vec4 solidRect;              // Opaque white texel (u0 == u1, v0 == v1)
+        const glm::vec4& rectFor(char c) const;
+    };
+    FontAtlas basicFont; // renderText, GL_NEAREST (fallback without the TrueType font)
+    FontAtlas hudFont;   // renderEnhancedText, GL_LINEAR (fallback without the TrueType font)
+    
+    // TrueType HUD font as a signed distance field, drawn by sdfShaderProgram at any size
+    SdfFont sdfFont;
+    GLuint sdfFontAtlas;
+    GLuint sdfShaderProgram;
+    void queueSdfText(const std::string& text, float x, float y, float charWidth, float charHeight,
+                      float spacing, const glm::vec4& color);
+    bool buildFontAtlas(FontAtlas& font, const unsigned char* coverage, int glyphSize, GLint filter);
+    void releaseFontAtlas(FontAtlas& font);
+    
+    // Sprite batch: UI quads queued in overlay space with final positions, atlas uvs and
+    // tint, copied into the stream buffer and drawn by flushSprites
+    struct SpriteVertex {
+        float x, y;
+        float u, v;
+        float quadU, quadV; // 0..1 across the sprite, for the border effect
+        unsigned char color[4];
+    };
+    struct SpriteRun {
+        GLuint program;
+        GLuint texture;
+        size_t firstQuad;
+        size_t quadCount;
+    };
+    GLuint spriteVAO;      // Vertices come from streamBuffer, addressed by base vertex
+    GLuint spriteEBO;      // Static quad indices, grown with spriteCapacity
+    size_t spriteCapacity; // In quads
+    std::vector<SpriteVertex> spriteVertices;
+    std::vector<SpriteRun> spriteRuns; // Consecutive sprites sharing a program and texture
+    unsigned int spriteBufferGeneration; // StreamBuffer generation spriteVAO points at
+    void pushSprite(GLuint program, GLuint texture, const glm::vec4& rect, float centerX, float centerY,
+                    float width, float height, const glm::vec4& color, float rotation = 0.0f);
+    
+    // Per-frame card instances and sprite vertices, written straight into mapped memory
+    static constexpr size_t STREAM_SEGMENT_BYTES = 256 * 1024;
+    StreamBuffer streamBuffer;
+    void pointCardInstances(GLintptr offset);
+    void pointSpriteVertices();
+    
+    // Retained layers: each renders into its own framebuffer only when dirty, and endFrame
+    // composites the cached textures in one full-screen draw. The HUD layer matches the
+    // viewport; the board and animation layers are the viewport times the render scale.
+    struct RenderLayer {
+        GLuint framebuffer = 0;
+        GLuint texture = 0; // RGBA8, premultiplied alpha
+        int width = 0;
+        int height = 0;
+        bool dirty = true;
+        bool regionDirty = false; // Only region needs redrawing (window pixels, origin bottom left)
+        int regionX0 = 0, regionY0 = 0, regionX1 = 0, regionY1 = 0;
+    };
+    static constexpr int LAYER_COUNT = 3;
+    RenderLayer renderLayers[LAYER_COUNT];
+    int activeLayer; // Layer being rendered between beginLayer and endLayer, or -1
+    GLuint compositeProgram;
+    GLuint compositeScaledProgram; // Filters scaled board and animation layers up
+    GLuint compositeVAO; // Empty; the composite triangle comes from gl_VertexID
+    glm::vec4 backgroundColor;
+    GLuint targetFramebuffer; // Where frames end up: 0 is the window
+    bool createLayers();
+    bool allocateLayer(RenderLayer& layer, int width, int height);
+    void releaseLayer(RenderLayer& layer);
+    void releaseLayers();
+    void compositeLayers();
+    
+    // Last camera uploaded to the uniform block; unchanged frames skip the upload
+    glm::mat4 uploadedView;
+    glm::mat4 uploadedProjection;
+    bool cameraUploaded;
+    
+    // One fence per submitted frame, oldest first, for bounding frames in flight
+    struct FrameFence {
+        GLsync sync;
+        unsigned long long frame;
+    };
+    std::deque<FrameFence> frameFences;
+    int maxFramesInFlight;          // 0 = leave queueing to the driver
+    unsigned long long frameNumber;    // Frames ended so far
+    unsigned long long completedFrame; // Newest frame the GPU is known to have finished
+    void releaseFrameFences();
+    
+    // Dynamic resolution: the cost of each frame that redraws a scaled layer, from
+    // beginFrame to endFrame plus any wait for a frame slot before it, drives the scale
+    ResolutionScaler resolutionScaler;
+    std::chrono::steady_clock::time_point frameBeginTime;
+    float slotWaitMilliseconds; // Blocked in waitForFrameSlot since the last endFrame
+    bool sceneRedrawn;          // Board or animation layer redrawn this frame
+    
+    // GPU time of each pass, read back a few frames late; idle until profiling is enabled
+    enum GpuPass {
+        PASS_BOARD,     // Same order as Layer
+        PASS_ANIMATION,
+        PASS_HUD,
+        PASS_COMPOSITE,
+        PASS_OVERLAY,   // Sprites drawn straight into the target after compositing
+        PASS_COUNT
+    };
+    GpuProfiler gpuProfiler;
+    bool gpuTimingOverlay;
+    void queueGpuTimingOverlay();
+    
+    GLCallStats frameStats;
+    GLCallStats lastFrameStats;
+    
+    // Linked programs from earlier runs; loadShader tries them before compiling
+    ProgramBinaryCache programCache;
+    bool programCacheEnabled = true;
+    bool programBinariesSupported = false; // Driver offers at least one binary format
+    int programsFromCache = 0;
+    int programsCompiled = 0;
+    float shaderMilliseconds = 0.0f; // Time spent in loadShader, reading files included
+    GLuint loadProgramBinary(uint64_t sourceKey);
+    void saveProgramBinary(GLuint program, uint64_t sourceKey);
+    
+    void uploadCardFace(int layer);
+    void queueCardFaceUploads(const std::vector<int>& layers); // One loader job for the batch
+    void completeCardFace(int layer); // The GPU has the face: drop its pixels, redraw
+    static void writeCardFace(GLuint atlas, GLuint palette, bool indexed, int layer,
+                              const unsigned char* pixels, const unsigned char* paletteRow);
+    void waitForCardFaceJobs();
+    void releaseCardAtlas();
     float viewportWidth = 1280.0f;
     float viewportHeight = 720.0f;
     
@@ -27,14 +225,126 @@ public:
     bool initialize();
     void cleanup();
     
+    // Reuse linked programs across runs (on by default); set before initialize
+    void setProgramCacheEnabled(bool enabled) { programCacheEnabled = enabled; }
+    
     // Shader management
     GLuint loadShader(const std::string& vertexPath, const std::string& fragmentPath);
     GLuint compileShader(const std::string& source, GLenum shaderType);
     
-    // Texture management
+    // Texture management. loadTexture returns a 1x1 white texture at once and fills it
+    // from the file (binary PPM) on the asset loader; it is usable in either state.
     GLuint loadTexture(const std::string& path);
     GLuint createCardTexture(int rank, int suit, bool isFront = true);
     
+    // Card atlas: layer 0 holds the shared back, then one layer per unique (rank, suit).
+    // Building only uploads the back; each face is generated the first time it is needed.
+    static constexpr int CARD_BACK_LAYER = 0;
+    static std::vector<int> assignCardLayers(const std::vector<std::pair<int, int>>& faces); // Layer of each face, no GL
+    std::vector<int> buildCardAtlas(const std::vector<std::pair<int, int>>& faces);
+    void requestCardFace(int layer);   // Start generating a face in the background
+    void finishCardFace(int layer);    // Block until a face is generated, then upload it
+    void uploadReadyCardFaces();       // Upload faces the workers have finished, without waiting
+    
+    // Background uploads through a context sharing objects with this one, driven by
+    // callbacks that bind (true on success) and unbind it on the loader thread. Faces of
+    // a new deal then stream in behind the first frame. Without it, uploads stay on
+    // this thread and faces are generated when first needed.
+    bool startAssetLoader(std::function<bool()> makeCurrent, std::function<void()> release);
+    const AssetLoader& getAssetLoader() const { return assetLoader; }
+    bool isLoadingAssets() const { return loadingAssets; } // Faces still streaming in (any thread)
+    
+    // "Loading faces n/m" bottom left while faces stream in; drawn outside the layers
+    void setLoadingOverlay(bool enabled) { loadingOverlay = enabled; }
+    bool getLoadingOverlay() const { return loadingOverlay; }
+    void bindCardAtlas(); // Prepares the card shader for a board, in either face mode
+    
+    // Draw a whole board with one instanced draw call
+    void drawCards(const std::vector<CardInstance>& instances);
+    
+    // Camera block layout (std140): mat4 view, mat4 projection, mat4 overlay
+    static constexpr GLuint CAMERA_BINDING = 0;
+    
+    // Upload this frame's camera once for all programs (if it moved) and start counting
+    // GL work; endFrame composites the layers and publishes the counts as the last frame's stats
+    void beginFrame(const glm::mat4& view, const glm::mat4& projection);
+    void endFrame();
+    
+    // Draw every queued sprite (text, panels, renderCard) in submission order, one draw call
+    // per run of sprites sharing a program and texture. endFrame flushes automatically; flush earlier to
+    // put later 3D drawing on top of the UI.
+    void flushSprites();
+    
+    // Retained-mode layers, back to front. A layer is re-rendered only after it is marked
+    // dirty; otherwise the frame reuses its cached framebuffer. Drawing between
+    // beginLayer and endLayer (cards and queued sprites) goes into the layer.
+    enum class Layer {
+        BOARD,     // Background and resting cards
+        ANIMATION, // Cards in motion
+        HUD        // Text and panels
+    };
+    void markLayerDirty(Layer layer);
+    void markAllLayersDirty();
+    
+    // Only part of a layer changed: the redraw is scissored to the bounding box of the
+    // marked rectangles (window pixels, origin bottom left). Draw the whole layer as
+    // usual; everything outside the box keeps its cached pixels.
+    void markLayerRegionDirty(Layer layer, int x, int y, int width, int height);
+    bool beginLayer(Layer layer); // False when the layer is clean: skip drawing it
+    void endLayer();
+    
+    // Dynamic resolution: the board and animation layers render at a fraction of the
+    // viewport and the composite upscales them (bilinear); the HUD keeps native
+    // resolution. With a budget the fraction follows the measured frame cost (see
+    // ResolutionScaler); 0 turns scaling off. Bound the frames in flight so a GPU-bound
+    // frame shows up as time waiting for a slot.
+    void setFrameBudget(float milliseconds);
+    float getFrameBudget() const { return resolutionScaler.getBudget(); }
+    float getRenderScale() const { return resolutionScaler.getScale(); }
+    const ResolutionScaler& getResolutionScaler() const { return resolutionScaler; }
+    
+    // Clear color of the board layer (and of the window)
+    void setBackgroundColor(const glm::vec4& color);
+    
+    // Framebuffer frames are composited into: 0 for the window, or an offscreen
+    // target (headless mode). It must be bound while drawing outside layers.
+    void setTargetFramebuffer(GLuint framebuffer) { targetFramebuffer = framebuffer; }
+    GLuint getTargetFramebuffer() const { return targetFramebuffer; }
+    
+    // Cached uniform lookup (-1 when the program has no such active uniform)
+    GLint getUniformLocation(GLuint program, const std::string& name) const;
+    
+    // Frame pipelining: endFrame fences every frame. waitForFrameSlot blocks until fewer
+    // than maxFramesInFlight earlier frames are still queued or executing (call it before
+    // sampling input, so the input is as fresh as possible), and otherwise just notes
+    // which frames have completed.
+    void setMaxFramesInFlight(int frames) { maxFramesInFlight = std::max(frames, 0); }
+    int getMaxFramesInFlight() const { return maxFramesInFlight; }
+    void waitForFrameSlot();
+    unsigned long long getFrameNumber() const { return frameNumber; } // Number of the last frame ended
+    unsigned long long getCompletedFrame() const { return completedFrame; }
+    
+    const GLCallStats& getLastFrameStats() const { return lastFrameStats; }
+    void printFrameStats() const;
+    
+    // GL_TIME_ELAPSED per pass (board, animation, HUD, composite, overlay), averaged over
+    // the last GpuProfiler::HISTORY samples. Results arrive GpuProfiler::FRAMES_IN_FLIGHT
+    // frames late, so timing never waits for the GPU. The overlay draws them top right.
+    void setGpuProfiling(bool enabled);
+    bool getGpuProfiling() const { return gpuProfiler.isInitialized(); }
+    void setGpuTimingOverlay(bool enabled) { gpuTimingOverlay = enabled; }
+    bool getGpuTimingOverlay() const { return gpuTimingOverlay; }
+    void printGpuTimings() const;
+    
+    // Procedural faces need no atlas at all; the CPU atlas stays as fallback and reference
+    void setProceduralFaces(bool enabled);
+    bool getProceduralFaces() const { return proceduralFaces; }
+    
+    // Palette-indexed atlas (default) vs. full RGBA8; switching drops the current atlas
+    void setIndexedFaces(bool enabled);
+    bool getIndexedFaces() const { return indexedFaces; }
+    size_t getCardAtlasBytes() const; // Texture memory held by the atlas and its palette
+    
     // Rendering functions
     void renderCard(float x, float y, float width, float height, float rotation, GLuint texture);
     void renderText(const std::string& text, float x, float y, float scale);
@@ -49,4 +359,5 @@ public:
     // Getters
     GLuint getCardShaderProgram() const { return cardShaderProgram; }
     GLuint getTextShaderProgram() const { return textShaderProgram; }
+    GLuint getCardAtlas() const { return cardAtlas; }
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+// Picks the resolution of the board layers from measured frame times (no GL). The
+// renderer reports the cost of every frame that redraws the scaled layers; after
+// WINDOW such frames the average is compared with the budget. Over budget, the scale
+// drops straight to the size expected to fit (cost taken as proportional to the pixel
+// count); well under it, the scale rises one STEP at a time, and only if the larger
+// size is still expected to fit. Scales are multiples of STEP, so small timing noise
+// never reallocates the layers.
+class ResolutionScaler {
+public:
+    static constexpr float MIN_SCALE = 0.5f;
+    static constexpr float STEP = 0.0625f;  // 1/16 of the viewport per axis
+    static constexpr int WINDOW = 12;       // Frames averaged per decision
+    static constexpr float HEADROOM = 0.85f; // Aim this far under the budget
+
+    ResolutionScaler();
+
+    // Frame time to hold, in ms; 0 turns scaling off and restores full resolution
+    void setBudget(float milliseconds);
+    float getBudget() const { return budget; }
+    bool isEnabled() const { return budget > 0.0f; }
+
+    // Returns true if the scale changed
+    bool addFrame(float milliseconds);
+
+    float getScale() const { return scale; }
+    float getLastAverage() const { return lastAverage; } // Of the last full window
+    unsigned int getChanges() const { return changes; }
+
+private:
+    float budget;
+    float scale;
+    float total;
+    int count;
+    bool settling; // Next frame reallocates and redraws the layers: not counted
+    float lastAverage;
+    unsigned int changes;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// One baked glyph of an SdfFont atlas. Sizes and offsets are in atlas pixels;
+// the bitmap includes SdfFont::PADDING pixels of distance field on every side.
+struct FontGlyph {
+    float u0 = 0, v0 = 0, u1 = 0, v1 = 0; // Atlas rectangle, v0 at the bitmap's top row
+    int width = 0;
+    int height = 0;
+    int xOffset = 0; // Bitmap top-left relative to the pen on the baseline (y down)
+    int yOffset = 0;
+    float advance = 0;
+};
+
+// Signed-distance-field font baked once from a TrueType file with TrueTypeFont.
+// Every printable ASCII glyph is rendered at PIXEL_HEIGHT into a single R8 atlas
+// (top row first); the text shader thresholds the distance at 0.5, so the same
+// atlas stays sharp at any on-screen size and outlines/shadows are shader effects.
+class SdfFont {
+private:
+    std::vector<unsigned char> atlas;
+    int atlasWidth;
+    int atlasHeight;
+    FontGlyph glyphs[128];
+    FontGlyph solid; // Fully inside texels, for panels drawn with the text shader
+    float ascent;    // Pixels above the baseline at PIXEL_HEIGHT
+    float descent;   // Pixels below it (negative)
+
+public:
+    static constexpr int PIXEL_HEIGHT = 32; // Ascent to descent of the baked glyphs
+    static constexpr int PADDING = 4;       // Distance field margin around each glyph
+    static constexpr int ONEDGE_VALUE = 128;
+    static constexpr float PIXEL_DIST_SCALE = 32.0f; // Field units per pixel: PADDING pixels span 0..ONEDGE_VALUE
+    static constexpr int ATLAS_WIDTH = 256;
+
+    SdfFont();
+
+    // Read a .ttf and bake the atlas; fails if the file is missing or not a TrueType font
+    bool load(const std::string& path);
+    bool isLoaded() const { return !atlas.empty(); }
+
+    const std::vector<unsigned char>& getAtlas() const { return atlas; }
+    int getAtlasWidth() const { return atlasWidth; }
+    int getAtlasHeight() const { return atlasHeight; }
+
+    // Glyph for a character; characters the font lacks map to '?'
+    const FontGlyph& getGlyph(char c) const;
+    const FontGlyph& getSolid() const { return solid; }
+    float getAscent() const { return ascent; }
+    float getDescent() const { return descent; }
+};
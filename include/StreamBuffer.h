@@ -0,0 +1,60 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+// Ring allocator for per-frame dynamic vertex data (card instances, sprite quads).
+//
+// With ARB_buffer_storage the buffer is allocated once with glBufferStorage and
+// mapped persistently and coherently; it is split into SEGMENTS equal parts, one
+// per frame in flight. Each frame appends into its own segment with a plain
+// memcpy (no GL call, no driver copy), and endFrame fences the segment and waits
+// for the fence of the segment it moves on to, which the GPU finished frames ago.
+//
+// Without it, the whole buffer is used as one stream: writes map unsynchronized
+// ranges after the previous ones, and a write that no longer fits orphans the
+// storage and starts over at offset 0.
+class StreamBuffer {
+public:
+    static constexpr int SEGMENTS = 3; // Frames that may write and draw concurrently
+    
+private:
+    GLuint buffer;
+    bool persistent;
+    unsigned char* mapped;   // Persistent mapping of the whole buffer
+    size_t segmentSize;      // Bytes per frame segment
+    int segment;             // Segment the current frame writes into
+    size_t cursor;           // Next free byte, from the start of the buffer
+    GLsync fences[SEGMENTS]; // Pending GPU use of each segment
+    unsigned int generation; // Changes whenever the buffer object is replaced
+    unsigned int stalls;     // endFrame waits that actually blocked
+    
+    bool allocate(size_t bytesPerSegment);
+    void releaseFences();
+    
+public:
+    StreamBuffer();
+    ~StreamBuffer();
+    
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+    
+    // Persistent mapping when allowed and supported, orphaning otherwise
+    bool create(size_t bytesPerSegment, bool allowPersistent = true);
+    void release();
+    
+    // Copy bytes into this frame's part of the buffer at a multiple of alignment
+    // (alignment need not be a power of two, so vertex offsets can be whole
+    // vertices). Returns the byte offset, or -1 on failure. A frame that outgrows
+    // its segment reallocates the buffer; callers watch getGeneration() to
+    // re-point vertex attributes at the new object.
+    GLintptr write(const void* data, size_t bytes, size_t alignment);
+    
+    // Fence this frame's writes and move on to the next segment
+    void endFrame();
+    
+    GLuint getBuffer() const { return buffer; }
+    bool isPersistent() const { return persistent; }
+    size_t getSegmentSize() const { return segmentSize; }
+    unsigned int getGeneration() const { return generation; }
+    unsigned int getStalls() const { return stalls; }
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+
+// Lock-free hand-off of the newest value from one producer thread to one consumer
+// thread. The producer always owns a slot to fill and the consumer a slot to read;
+// the third slot holds the newest published value. Publishing and taking the newest
+// value are one atomic exchange each, so neither side ever waits for the other, and
+// a consumer that falls behind simply skips to the newest value.
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr unsigned int INDEX_MASK = 3;
+    static constexpr unsigned int FRESH = 4; // The shared slot holds a value not yet acquired
+    
+    T slots[3];
+    std::atomic<unsigned int> shared; // Index of the middle slot, plus FRESH
+    unsigned int writeSlot;           // Producer side only
+    unsigned int readSlot;            // Consumer side only
+    
+public:
+    TripleBuffer() : shared(2), writeSlot(0), readSlot(1) {}
+    
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+    
+    // Producer: fill this slot completely (it holds an older value), then publish it
+    T& writeBuffer() { return slots[writeSlot]; }
+    void publish() {
+        writeSlot = shared.exchange(writeSlot | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    
+    // Consumer: take the newest published value, if there is one it has not seen yet.
+    // readBuffer() stays valid and unchanged until the next successful acquire.
+    bool acquire() {
+        if ((shared.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        readSlot = shared.exchange(readSlot, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return slots[readSlot]; }
+};
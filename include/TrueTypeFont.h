@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Minimal TrueType reader used to bake SdfFont: our own implementation, not a
+// vendored library. stb_truetype would bring about ten times the code for
+// features the bake never uses. It also takes no buffer length and assumes a
+// trusted file, while this reader is bounds-checked throughout. It maps codepoints through the cmap, reads horizontal
+// metrics and glyf outlines (simple and composite), and renders a glyph's
+// signed distance field. CFF-flavoured fonts, kerning and hinting are not
+// supported. Every table offset and length is checked against the file size
+// when the font is opened, and every outline read against its glyph's extent,
+// so a truncated or corrupt file fails to open or yields empty glyphs rather
+// than reading out of bounds.
+class TrueTypeFont {
+public:
+    // One outline command in font units (y up)
+    enum VertexType : uint8_t { MOVE = 1, LINE, CURVE };
+    struct Vertex {
+        int16_t x, y;   // End point
+        int16_t cx, cy; // Control point of a CURVE
+        VertexType type;
+    };
+
+    TrueTypeFont();
+
+    // Open the font at index fontIndex of a .ttf/.ttc image. data must stay valid
+    // for as long as this object is used; returns false if the file is not a
+    // TrueType font or any table it needs lies outside the file.
+    bool open(const unsigned char* data, size_t size, int fontIndex = 0);
+
+    // Glyph index for a Unicode codepoint, 0 if the font has no such glyph
+    int findGlyphIndex(int codepoint) const;
+
+    // Scale that maps ascent - descent to the given height in pixels
+    float scaleForPixelHeight(float pixels) const;
+
+    // Metrics in unscaled font units; descent is usually negative
+    void getVMetrics(int& ascent, int& descent, int& lineGap) const;
+    void getGlyphHMetrics(int glyph, int& advanceWidth, int& leftSideBearing) const;
+
+    // Bounding box of the glyph's outline in font units; false for glyphs without one
+    bool getGlyphBox(int glyph, int& x0, int& y0, int& x1, int& y1) const;
+
+    // Outline as move/line/quadratic-curve commands; empty for blank or malformed glyphs
+    std::vector<Vertex> getGlyphShape(int glyph) const;
+
+    // Largest SDF bitmap side, padding included, that getGlyphSdf will allocate
+    static constexpr int MAX_SDF_SIZE = 1024;
+
+    // Signed distance field of a glyph, top row first. Each pixel holds
+    //     onedgeValue + pixelDistScale * (distance to the outline in pixels),
+    // positive inside the glyph, clamped to 0..255. padding extra pixels surround
+    // the outline's box; xOffset/yOffset place the bitmap's top-left relative to
+    // the glyph origin (y down). Empty (and a 0x0 size) for blank glyphs, a scale that
+    // is not positive and finite, or a box larger than MAX_SDF_SIZE.
+    std::vector<unsigned char> getGlyphSdf(int glyph, float scale, int padding, unsigned char onedgeValue,
+                                           float pixelDistScale, int& width, int& height, int& xOffset,
+                                           int& yOffset) const;
+
+private:
+    struct Table {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    const unsigned char* data;
+    size_t size;
+    Table head, hhea, hmtx, loca, glyf;
+    Table indexMap; // The chosen Unicode cmap subtable, clipped to the cmap table
+    int numGlyphs;
+    int numLongHorMetrics;
+    int indexToLocFormat;
+
+    bool findTable(uint32_t fontStart, const char* tag, Table& table) const;
+    bool getGlyphRange(int glyph, uint32_t& start, uint32_t& end) const;
+    std::vector<Vertex> getGlyphShape(int glyph, int depth) const;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+// Fixed-size pool of CPU worker threads. Tasks must not touch OpenGL:
+// the GL context only lives on the thread that created it.
+class WorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    bool stopping;
+    
+    void workerLoop();
+    
+public:
+    // threadCount == 0 picks one worker per hardware thread
+    explicit WorkerPool(unsigned int threadCount = 0);
+    ~WorkerPool();
+    
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    
+    // Queue a task; the returned future becomes ready once it has run
+    std::future<void> submit(std::function<void()> task);
+    
+    size_t getThreadCount() const { return workers.size(); }
+};
@@ -1,25 +1,227 @@
 #version 330 core
 
 in vec2 TexCoord;
+flat in int CardLayer;
+flat in int ShowFront;
+flat in int CardRank;
+flat in int CardSuit;
+flat in vec3 PatternColor;
 out vec4 FragColor;
 
-uniform sampler2D cardTexture;
+uniform sampler2DArray cardAtlas;
+
+// Indexed mode: cardAtlas holds R8 palette indices, cardPalette one 256-entry row per layer
+uniform bool indexedFaces = false;
+uniform sampler2D cardPalette;
 uniform vec3 cardColor = vec3(1.0, 1.0, 1.0);
 uniform float alpha = 1.0;
 
+// Procedural mode: faces are evaluated here instead of sampled from the atlas
+uniform bool proceduralFaces = false;
+
+const float SIZE = 128.0; // Matches Card::TEXTURE_SIZE so both paths share one layout
+
+// C-style remainder and division (truncate toward zero), as in Card.cpp
+float cmod(float a, float b) { return a - b * trunc(a / b); }
+float cdiv(float a, float b) { return trunc(a / b); }
+
+vec3 rgb(float r, float g, float b) { return vec3(r, g, b) / 255.0; }
+
+// Same families as Card::patternContains; dx/dy are continuous so edges stay sharp
+bool patternContains(int pattern, float dx, float dy, float dist)
+{
+    float adx = abs(dx);
+    float ady = abs(dy);
+    switch (pattern) {
+        case 0: // Concentric circles
+            return cmod(dist, 400.0) < 50.0 && dist > 100.0 && dist < 2500.0;
+        case 1: // Diamond pattern
+            return cmod(adx + ady, 30.0) < 5.0 && adx + ady < 50.0;
+        case 2: // Cross pattern
+            return (adx < 8.0 && ady < 40.0) || (ady < 8.0 && adx < 40.0);
+        case 3: // Star pattern
+            return (adx < 3.0 && ady < 35.0) || (ady < 3.0 && adx < 35.0) ||
+                   (abs(dx - dy) < 3.0 && adx < 25.0) || (abs(dx + dy) < 3.0 && adx < 25.0);
+        case 4: { // Spiral pattern
+            float angle = atan(dy, dx);
+            float radius = sqrt(dist);
+            return cmod(trunc(angle * 3.0 + radius * 0.1), 10.0) < 2.0 && radius < 45.0;
+        }
+        case 5: // Triangle pattern
+            return dy > 0.0 && adx < 50.0 - dy && dy < 45.0;
+        case 6: { // Hexagon pattern
+            float hexDist = adx + abs(dy * 0.866 + dx * 0.5) + abs(dy * 0.866 - dx * 0.5);
+            return (hexDist > 30.0 && hexDist < 40.0) || (hexDist > 15.0 && hexDist < 20.0);
+        }
+        case 7: { // Flower pattern
+            float angle = atan(dy, dx);
+            float radius = sqrt(dist);
+            float petalRadius = 25.0 + 10.0 * cos(angle * 6.0);
+            return radius > petalRadius - 3.0 && radius < petalRadius + 3.0 && radius < 45.0;
+        }
+        case 8: // Grid pattern
+            return (cmod(dx, 15.0) < 3.0 || cmod(dy, 15.0) < 3.0) && adx < 40.0 && ady < 40.0;
+        case 9: { // Waves pattern
+            float wave = sin(dx * 0.2) * 8.0;
+            return abs(dy - wave) < 4.0 && adx < 45.0;
+        }
+        case 10: // Checkerboard
+            return cmod(cdiv(dx, 10.0) + cdiv(dy, 10.0), 2.0) == 0.0 && adx < 40.0 && ady < 40.0;
+        case 11: { // Concentric squares
+            float maxDist = max(adx, ady);
+            return cmod(maxDist, 12.0) < 3.0 && maxDist > 10.0 && maxDist < 45.0;
+        }
+        case 12: // Plus signs
+            return ((cmod(adx, 20.0) < 3.0 && cmod(ady, 20.0) < 12.0) ||
+                    (cmod(ady, 20.0) < 3.0 && cmod(adx, 20.0) < 12.0)) && adx < 45.0 && ady < 45.0;
+        case 13: { // Zigzag pattern
+            float zigzag = cmod(dx + dy, 30.0);
+            return (zigzag < 6.0 || zigzag > 24.0) && adx < 45.0 && ady < 45.0;
+        }
+        case 14: { // Circular dots
+            float dotX = cdiv(dx + 60.0, 20.0) * 20.0 - 60.0;
+            float dotY = cdiv(dy + 60.0, 20.0) * 20.0 - 60.0;
+            float dotDist = (dx - dotX) * (dx - dotX) + (dy - dotY) * (dy - dotY);
+            return dotDist < 25.0 && adx < 45.0 && ady < 45.0;
+        }
+        case 15: // Diagonal stripes
+            return cmod(dx - dy, 15.0) < 4.0 && adx < 45.0 && ady < 45.0;
+    }
+    return false;
+}
+
+// texel: integer texel of the CPU layout (borders, grids, indicators)
+// p: continuous position, integral at texel centers (curves and patterns)
+vec3 proceduralFront(ivec2 texel, vec2 p)
+{
+    int x = texel.x;
+    int y = texel.y;
+    int size = int(SIZE);
+    vec3 color = rgb(250.0, 250.0, 250.0);
+
+    if (x < 3 || x >= size - 3 || y < 3 || y >= size - 3) {
+        color = rgb(20.0, 20.0, 20.0);
+    } else if (x < 6 || x >= size - 6 || y < 6 || y >= size - 6) {
+        color = rgb(200.0, 170.0, 100.0);
+    } else {
+        vec2 d = p - vec2(SIZE / 2.0);
+        if (patternContains((CardRank + CardSuit * 13) % 16, d.x, d.y, dot(d, d))) {
+            color = PatternColor;
+        }
+
+        // Rank-specific corner decorations (pattern color shaded by 1/2, 1/3, 1/4)
+        vec3 baseColor = floor(PatternColor * 255.0 + 0.5);
+        if (CardRank <= 4) {
+            vec2 near = vec2(15.0);
+            vec2 far = vec2(SIZE - 15.0);
+            float r2 = 16.0;
+            vec2 a = p - near;
+            vec2 b = p - vec2(far.x, near.y);
+            vec2 c = p - vec2(near.x, far.y);
+            vec2 e = p - far;
+            if (dot(a, a) < r2 || dot(b, b) < r2 || dot(c, c) < r2 || dot(e, e) < r2) {
+                color = floor(baseColor / 2.0) / 255.0;
+            }
+        } else if (CardRank <= 8) {
+            if ((x < 20 && (y < 20 || y > size - 20)) || (x > size - 20 && (y < 20 || y > size - 20))) {
+                if ((x + y) % 4 < 2) {
+                    color = floor(baseColor / 3.0) / 255.0;
+                }
+            }
+        } else {
+            if ((x < 18 && y < 18) || (x > size - 18 && y < 18) ||
+                (x < 18 && y > size - 18) || (x > size - 18 && y > size - 18)) {
+                color = floor(baseColor / 4.0) / 255.0;
+            }
+        }
+    }
+
+    // Rank indicator (top-left) and suit indicator (bottom-right)
+    if (x < 25 && y < 30) {
+        if ((x / 3 + y / 3) % 13 == (CardRank - 1) % 13) {
+            color = rgb(20.0, 20.0, 20.0);
+        }
+    } else if (x >= size - 25 && y >= size - 30) {
+        if ((x / 4 + y / 4) % 4 == CardSuit) {
+            color = rgb(60.0, 60.0, 60.0);
+        }
+    }
+    return color;
+}
+
+vec3 proceduralBack(ivec2 texel, vec2 p)
+{
+    int x = texel.x;
+    int y = texel.y;
+    int size = int(SIZE);
+
+    // Blue gradient background
+    int gradientFactor = (x + y) / 4;
+    vec3 color = vec3(40 + gradientFactor % 30, 60 + gradientFactor % 40, 120 + gradientFactor % 50);
+
+    // Decorative border
+    if (x < 6 || x >= size - 6 || y < 6 || y >= size - 6) {
+        color = vec3(20.0, 30.0, 60.0);
+    }
+
+    // Diamond lattice pattern
+    if ((x + y) % 16 < 2 || (x - y + size) % 16 < 2) {
+        color += vec3(30.0, 40.0, 30.0);
+    }
+
+    // Central ornamental ring and cross
+    vec2 d = p - vec2(SIZE / 2.0);
+    float dist = dot(d, d);
+    if (dist < 1000.0 && dist > 400.0 && cmod(dist, 50.0) < 10.0) {
+        color = vec3(150.0, 180.0, 200.0);
+    }
+    if ((abs(d.x) < 3.0 && abs(d.y) < 30.0) || (abs(d.y) < 3.0 && abs(d.x) < 30.0)) {
+        color = vec3(100.0, 130.0, 180.0);
+    }
+    return color / 255.0;
+}
+
+// Palette lookup for one index texel, clamped to the layer edge
+vec4 paletteTexel(ivec2 texel, int layer)
+{
+    texel = clamp(texel, ivec2(0), ivec2(int(SIZE) - 1));
+    int index = int(texelFetch(cardAtlas, ivec3(texel, layer), 0).r * 255.0 + 0.5);
+    return texelFetch(cardPalette, ivec2(index, layer), 0);
+}
+
+// Bilinear filtering after the palette lookup, matching GL_LINEAR on the RGBA atlas
+vec4 sampleIndexed(vec2 uv, int layer)
+{
+    vec2 p = uv * SIZE - 0.5;
+    ivec2 base = ivec2(floor(p));
+    vec2 f = fract(p);
+    vec4 top = mix(paletteTexel(base, layer), paletteTexel(base + ivec2(1, 0), layer), f.x);
+    vec4 bottom = mix(paletteTexel(base + ivec2(0, 1), layer), paletteTexel(base + ivec2(1, 1), layer), f.x);
+    return mix(top, bottom, f.y);
+}
+
 void main()
 {
-    vec4 texColor = texture(cardTexture, TexCoord);
-    
+    vec4 texColor;
+    if (proceduralFaces) {
+        vec2 p = TexCoord * SIZE - 0.5;
+        ivec2 texel = clamp(ivec2(floor(TexCoord * SIZE)), ivec2(0), ivec2(int(SIZE) - 1));
+        texColor = vec4(ShowFront != 0 ? proceduralFront(texel, p) : proceduralBack(texel, p), 1.0);
+    } else if (indexedFaces) {
+        texColor = sampleIndexed(TexCoord, CardLayer);
+    } else {
+        texColor = texture(cardAtlas, vec3(TexCoord, float(CardLayer)));
+    }
+
     // Apply card color tint
     vec3 finalColor = texColor.rgb * cardColor;
-    
+
     // Add a border effect
     vec2 border = step(vec2(0.05), TexCoord) * (1.0 - step(vec2(0.95), TexCoord));
     float borderFactor = border.x * border.y;
-    
+
     // Make border slightly darker
     finalColor = mix(finalColor * 0.7, finalColor, borderFactor);
-    
+
     FragColor = vec4(finalColor, texColor.a * alpha);
-}
\ No newline at end of file
+}
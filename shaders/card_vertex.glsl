@@ -3,14 +3,42 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Per-instance card data (CardInstance in Card.h)
+layout (location = 2) in vec3 aCard;          // x, y, flip angle in degrees
+layout (location = 3) in ivec4 aFace;         // atlas layer, showFront, rank, suit
+layout (location = 4) in vec4 aPatternColor;  // normalized RGB
+
+// Updated once per frame by Renderer::beginFrame
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 overlay;
+};
+
+uniform vec2 cardSize;
 
 out vec2 TexCoord;
+flat out int CardLayer;
+flat out int ShowFront;
+flat out int CardRank;
+flat out int CardSuit;
+flat out vec3 PatternColor;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    // model = translate(x, y) * rotateY(angle) * scale(cardSize), as Card::draw used to build it
+    float angle = radians(aCard.z);
+    vec3 scaled = vec3(aPos.xy * cardSize, aPos.z);
+    vec3 rotated = vec3(scaled.x * cos(angle) + scaled.z * sin(angle),
+                        scaled.y,
+                        -scaled.x * sin(angle) + scaled.z * cos(angle));
+    vec4 world = vec4(rotated + vec3(aCard.xy, 0.0), 1.0);
+
+    gl_Position = projection * view * world;
     TexCoord = aTexCoord;
-}
\ No newline at end of file
+    CardLayer = aFace.x;
+    ShowFront = aFace.y;
+    CardRank = aFace.z;
+    CardSuit = aFace.w;
+    PatternColor = aPatternColor.rgb;
+}
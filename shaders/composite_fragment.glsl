@@ -0,0 +1,22 @@
+#version 330 core
+
+out vec4 FragColor;
+
+// Cached layers (Renderer::Layer), viewport-sized with premultiplied alpha
+uniform sampler2D boardLayer;     // Opaque: background and resting cards
+uniform sampler2D animationLayer; // Flipping cards
+uniform sampler2D hudLayer;       // Text and panels
+
+void main()
+{
+    // Layers match the viewport texel for texel, so no filtering or uvs are needed
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    vec4 color = texelFetch(boardLayer, texel, 0);
+    vec4 animation = texelFetch(animationLayer, texel, 0);
+    vec4 hud = texelFetch(hudLayer, texel, 0);
+    
+    // Back to front "over" with premultiplied colors
+    color = animation + color * (1.0 - animation.a);
+    color = hud + color * (1.0 - hud.a);
+    FragColor = vec4(color.rgb, 1.0);
+}
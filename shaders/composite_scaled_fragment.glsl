@@ -0,0 +1,24 @@
+#version 330 core
+
+out vec4 FragColor;
+
+// composite_fragment.glsl for dynamic resolution: the board and animation layers are
+// smaller than the viewport and filtered up; the HUD stays at native resolution
+uniform sampler2D boardLayer;     // Opaque: background and resting cards
+uniform sampler2D animationLayer; // Flipping cards
+uniform sampler2D hudLayer;       // Text and panels
+
+void main()
+{
+    // The scaled layers are sampled at the window pixel's relative position
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    vec2 uv = gl_FragCoord.xy / vec2(textureSize(hudLayer, 0));
+    vec4 color = texture(boardLayer, uv);
+    vec4 animation = texture(animationLayer, uv);
+    vec4 hud = texelFetch(hudLayer, texel, 0);
+    
+    // Back to front "over" with premultiplied colors
+    color = animation + color * (1.0 - animation.a);
+    color = hud + color * (1.0 - hud.a);
+    FragColor = vec4(color.rgb, 1.0);
+}
@@ -0,0 +1,25 @@
+#version 330 core
+
+in vec2 TexCoord;
+in vec2 QuadCoord;
+in vec4 Tint;
+out vec4 FragColor;
+
+uniform sampler2D cardTexture;
+
+void main()
+{
+    vec4 texColor = texture(cardTexture, TexCoord);
+    
+    // Apply the sprite's tint
+    vec3 finalColor = texColor.rgb * Tint.rgb;
+    
+    // Add a border effect
+    vec2 border = step(vec2(0.05), QuadCoord) * (1.0 - step(vec2(0.95), QuadCoord));
+    float borderFactor = border.x * border.y;
+    
+    // Make border slightly darker
+    finalColor = mix(finalColor * 0.7, finalColor, borderFactor);
+    
+    FragColor = vec4(finalColor, texColor.a * Tint.a);
+}
\ No newline at end of file
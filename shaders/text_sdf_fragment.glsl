@@ -0,0 +1,35 @@
+#version 330 core
+
+in vec2 TexCoord;
+in vec2 QuadCoord;
+in vec4 Tint;
+out vec4 FragColor;
+
+// R8 signed distance field: 0.5 on the glyph edge, larger inside
+uniform sampler2D fontAtlas;
+uniform float outlineWidth = 0.2;      // Distance field units outside the edge
+uniform vec2 shadowOffset = vec2(0.0); // Atlas uv; +v is down on screen
+uniform vec3 outlineColor = vec3(0.0, 0.0, 0.0);
+uniform float shadowAlpha = 0.6;
+
+// Antialiased coverage of distance >= edge, one screen pixel wide at any scale
+float coverage(float dist, float edge)
+{
+    float width = max(fwidth(dist), 1e-4);
+    return clamp((dist - edge) / width + 0.5, 0.0, 1.0);
+}
+
+void main()
+{
+    float dist = texture(fontAtlas, TexCoord).r;
+    float fill = coverage(dist, 0.5);
+    float outline = coverage(dist, 0.5 - outlineWidth);
+    float shadow = coverage(texture(fontAtlas, TexCoord - shadowOffset).r, 0.5 - outlineWidth) * shadowAlpha;
+
+    // Tinted fill inside a dark outline, over a soft drop shadow, all in one pass
+    vec3 body = mix(outlineColor, Tint.rgb, fill / max(outline, 1e-4));
+    float alpha = outline + shadow * (1.0 - outline);
+    vec3 color = body * outline / max(alpha, 1e-4);
+
+    FragColor = vec4(color, alpha * Tint.a);
+}
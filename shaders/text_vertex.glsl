@@ -0,0 +1,26 @@
+#version 330 core
+
+// Sprite batch vertices: positions are already in overlay space (-1..1 on both axes)
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;  // Font atlas (or sprite texture) coordinates
+layout (location = 2) in vec2 aQuadCoord; // 0..1 across the sprite
+layout (location = 3) in vec4 aColor;     // Tint and opacity
+
+// Shared with card_vertex.glsl; UI only uses the fixed overlay projection
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 overlay;
+};
+
+out vec2 TexCoord;
+out vec2 QuadCoord;
+out vec4 Tint;
+
+void main()
+{
+    gl_Position = overlay * vec4(aPos, 0.0, 1.0);
+    TexCoord = aTexCoord;
+    QuadCoord = aQuadCoord;
+    Tint = aColor;
+}
@@ -0,0 +1,164 @@
+#include "AssetLoader.h"
+#include <iostream>
+
+AssetLoader::AssetLoader()
+    : stopping(false), nextTicket(1), completedTicket(0), uploads(0), blockingWaits(0), pending(0) {
+}
+
+AssetLoader::~AssetLoader() {
+    stop();
+}
+
+bool AssetLoader::start(std::function<bool()> makeCurrentHook, std::function<void()> releaseHook) {
+    stop();
+    makeCurrent = std::move(makeCurrentHook);
+    release = std::move(releaseHook);
+    stopping = false;
+
+    // The loader reports whether it could bind its context before taking any work
+    std::promise<bool> started;
+    std::future<bool> result = started.get_future();
+    loader = std::thread(&AssetLoader::loaderLoop, this, &started);
+    if (!result.get()) {
+        loader.join();
+        std::cerr << "Asset loader context unavailable, uploading on the GL thread" << std::endl;
+        return false;
+    }
+    std::cout << "Asset loader thread started (shared context, fenced uploads)" << std::endl;
+    return true;
+}
+
+void AssetLoader::stop() {
+    if (!isThreaded()) {
+        return;
+    }
+    finish();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    loader.join();
+    std::cout << "Asset loader: " << uploads << " uploads on the loader thread, " << blockingWaits
+              << " waited for" << std::endl;
+}
+
+AssetLoader::Ticket AssetLoader::submit(std::function<void()> upload, std::function<void()> ready) {
+    Job job;
+    job.ticket = nextTicket++;
+    job.upload = std::move(upload);
+    job.ready = std::move(ready);
+    pending++;
+
+    if (!isThreaded()) {
+        job.upload();
+        complete(job);
+        return job.ticket;
+    }
+    // Flushed, or the loader's wait on it might never end
+    job.submitted = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.push_back(std::move(job));
+    }
+    wake.notify_one();
+    return nextTicket - 1;
+}
+
+void AssetLoader::poll() {
+    // Stop at the first fence still pending, so callbacks run in submission order
+    for (;;) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (fenced.empty() || glClientWaitSync(fenced.front().fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+                return;
+            }
+            job = std::move(fenced.front());
+            fenced.pop_front();
+        }
+        complete(job);
+    }
+}
+
+void AssetLoader::wait(Ticket ticket) {
+    if (completedTicket >= ticket) {
+        return;
+    }
+    blockingWaits++;
+    while (completedTicket < ticket) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            uploaded.wait(lock, [this] { return !fenced.empty(); });
+            job = std::move(fenced.front());
+            fenced.pop_front();
+        }
+        complete(job);
+    }
+}
+
+void AssetLoader::finish() {
+    wait(nextTicket - 1);
+}
+
+void AssetLoader::complete(Job& job) {
+    if (job.fence != nullptr) {
+        // The loader flushed after the fence, so it signals without help from this context
+        GLenum state;
+        do {
+            state = glClientWaitSync(job.fence, 0, 1000000000); // 1 s
+        } while (state == GL_TIMEOUT_EXPIRED);
+        if (state == GL_WAIT_FAILED) {
+            std::cerr << "Asset upload fence failed, using the resource anyway" << std::endl;
+        }
+        glDeleteSync(job.fence);
+        job.fence = nullptr;
+        uploads++;
+    }
+    if (job.ready) {
+        job.ready();
+    }
+    completedTicket = job.ticket;
+    pending--;
+}
+
+void AssetLoader::loaderLoop(std::promise<bool>* started) {
+    if (!makeCurrent()) {
+        started->set_value(false);
+        return;
+    }
+    started->set_value(true);
+
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queued.empty(); });
+            if (queued.empty()) {
+                break; // Stopping, and every job was handed back
+            }
+            job = std::move(queued.front());
+            queued.pop_front();
+        }
+
+        if (job.submitted != nullptr) {
+            glWaitSync(job.submitted, 0, GL_TIMEOUT_IGNORED); // On the GPU; returns at once
+            glDeleteSync(job.submitted);
+            job.submitted = nullptr;
+        }
+        job.upload();
+
+        // The flush sends the fence on its way; otherwise it could sit in this
+        // context's command queue and the GL thread would wait on it forever
+        job.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            fenced.push_back(std::move(job));
+        }
+        uploaded.notify_one();
+    }
+    release();
+}
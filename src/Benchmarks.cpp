@@ -0,0 +1,47 @@
+// Throughput benchmarks for CPU-side card texture generation.
+#include "Card.h"
+#include "CardRasterizer.h"
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+// Keeps the optimizer from discarding the generated pixels
+static volatile size_t benchmarkSink = 0;
+
+template <typename Generate>
+static double facesPerSecond(int rounds, Generate generate) {
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t checksum = 0;
+    for (int round = 0; round < rounds; round++) {
+        for (int suit = 0; suit < 4; suit++) {
+            for (int rank = 1; rank <= 13; rank++) {
+                std::vector<unsigned char> pixels = generate(rank, suit);
+                checksum += pixels[(rank * 131 + suit * 17) % pixels.size()];
+            }
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    benchmarkSink = benchmarkSink + checksum;
+    return rounds * 52 / elapsed.count();
+}
+
+int runAllBenchmarks() {
+    const int ROUNDS = 20;
+    double reference = facesPerSecond(ROUNDS, [](int rank, int suit) {
+        return Card::createDetailedCardPixels(rank, suit, true);
+    });
+    double fast = facesPerSecond(ROUNDS, [](int rank, int suit) {
+        return CardRasterizer::rasterize(rank, suit, true);
+    });
+    
+    std::cout << "Card face generation (" << Card::TEXTURE_SIZE << "x" << Card::TEXTURE_SIZE << ", 52 faces x "
+              << ROUNDS << " rounds)" << std::endl;
+    std::cout << "  scalar reference: " << reference << " faces/s" << std::endl;
+    std::cout << "  " << CardRasterizer::getInstructionSet() << " kernels: " << fast << " faces/s" << std::endl;
+    std::cout << "  speedup: " << fast / reference << "x" << std::endl;
+    return 0;
+}
+
+#ifdef RUN_BENCH_MAIN
+int main(){ return runAllBenchmarks(); }
+#endif
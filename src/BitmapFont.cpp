@@ -0,0 +1,895 @@
+#include "BitmapFont.h"
+
+namespace {
+
+// One glyph as drawn: top row first, one byte per texel
+template <int Size>
+struct Glyph {
+    unsigned char pixels[Size * Size] = {};
+    constexpr void set(int row, int col) { pixels[row * Size + col] = 255; }
+};
+
+// Classic 5x7 shapes for the characters neither font draws by hand: seven rows of
+// five columns, '#' for ink. Each font stretches them onto its own grid below.
+constexpr const char* classicPattern(char c) {
+    switch (c) {
+        case 'A': return ".###." "#...#" "#...#" "#####" "#...#" "#...#" "#...#";
+        case 'B': return "####." "#...#" "#...#" "####." "#...#" "#...#" "####.";
+        case 'D': return "####." "#...#" "#...#" "#...#" "#...#" "#...#" "####.";
+        case 'F': return "#####" "#...." "#...." "####." "#...." "#...." "#....";
+        case 'G': return ".###." "#...#" "#...." "#.###" "#...#" "#...#" ".####";
+        case 'H': return "#...#" "#...#" "#...#" "#####" "#...#" "#...#" "#...#";
+        case 'J': return "..###" "...#." "...#." "...#." "...#." "#..#." ".##..";
+        case 'K': return "#...#" "#..#." "#.#.." "##..." "#.#.." "#..#." "#...#";
+        case 'L': return "#...." "#...." "#...." "#...." "#...." "#...." "#####";
+        case 'P': return "####." "#...#" "#...#" "####." "#...." "#...." "#....";
+        case 'Q': return ".###." "#...#" "#...#" "#...#" "#.#.#" "#..#." ".##.#";
+        case 'X': return "#...#" "#...#" ".#.#." "..#.." ".#.#." "#...#" "#...#";
+        case 'Z': return "#####" "....#" "...#." "..#.." ".#..." "#...." "#####";
+        case '"': return ".#.#." ".#.#." ".#.#." "....." "....." "....." ".....";
+        case '#': return ".#.#." ".#.#." "#####" ".#.#." "#####" ".#.#." ".#.#.";
+        case '$': return "..#.." ".####" "#.#.." ".###." "..#.#" "####." "..#..";
+        case '%': return "##..." "##..#" "...#." "..#.." ".#..." "#..##" "...##";
+        case '&': return ".##.." "#..#." "#.#.." ".#..." "#.#.#" "#..#." ".##.#";
+        case '\'': return "..#.." "..#.." ".#..." "....." "....." "....." ".....";
+        case '(': return "...#." "..#.." ".#..." ".#..." ".#..." "..#.." "...#.";
+        case ')': return ".#..." "..#.." "...#." "...#." "...#." "..#.." ".#...";
+        case '*': return "....." "..#.." "#.#.#" ".###." "#.#.#" "..#.." ".....";
+        case '+': return "....." "..#.." "..#.." "#####" "..#.." "..#.." ".....";
+        case ',': return "....." "....." "....." "....." ".##.." "..#.." ".#...";
+        case '-': return "....." "....." "....." "#####" "....." "....." ".....";
+        case '.': return "....." "....." "....." "....." "....." ".##.." ".##..";
+        case '/': return "....." "....#" "...#." "..#.." ".#..." "#...." ".....";
+        case ';': return "....." ".##.." ".##.." "....." ".##.." "..#.." ".#...";
+        case '<': return "...#." "..#.." ".#..." "#...." ".#..." "..#.." "...#.";
+        case '=': return "....." "....." "#####" "....." "#####" "....." ".....";
+        case '>': return ".#..." "..#.." "...#." "....#" "...#." "..#.." ".#...";
+        case '?': return ".###." "#...#" "....#" "...#." "..#.." "....." "..#..";
+        case '@': return ".###." "#...#" "....#" ".##.#" "#.#.#" "#.#.#" ".###.";
+        case '[': return ".###." ".#..." ".#..." ".#..." ".#..." ".#..." ".###.";
+        case '\\': return "....." "#...." ".#..." "..#.." "...#." "....#" ".....";
+        case ']': return ".###." "...#." "...#." "...#." "...#." "...#." ".###.";
+        case '^': return "..#.." ".#.#." "#...#" "....." "....." "....." ".....";
+        case '_': return "....." "....." "....." "....." "....." "....." "#####";
+        case '`': return ".#..." "..#.." "...#." "....." "....." "....." ".....";
+        case '{': return "...#." "..#.." "..#.." ".#..." "..#.." "..#.." "...#.";
+        case '|': return "..#.." "..#.." "..#.." "..#.." "..#.." "..#.." "..#..";
+        case '}': return ".#..." "..#.." "..#.." "...#." "..#.." "..#.." ".#...";
+        case '~': return "....." "....." ".#..." "#.#.#" "...#." "....." ".....";
+        default: return nullptr;
+    }
+}
+
+// Draw a classic pattern, pattern column i covering glyph columns [columns[i], columns[i + 1])
+// and pattern row j covering glyph rows [rows[j], rows[j + 1])
+template <int Size>
+constexpr void drawPattern(Glyph<Size>& glyph, const char* pattern, const int (&columns)[6], const int (&rows)[8]) {
+    for (int j = 0; j < 7; j++) {
+        for (int i = 0; i < 5; i++) {
+            if (pattern[j * 5 + i] != '#') continue;
+            for (int row = rows[j]; row < rows[j + 1]; row++) {
+                for (int col = columns[i]; col < columns[i + 1]; col++) {
+                    glyph.set(row, col);
+                }
+            }
+        }
+    }
+}
+
+constexpr Glyph<BitmapFont::BASIC_SIZE> basicGlyph(char c) {
+    Glyph<BitmapFont::BASIC_SIZE> glyph;
+
+    // Draw character pattern (enhanced pixel art for 12x12)
+    switch (c) {
+        case '0': case 'O':
+            // Draw O shape
+            for (int row = 2; row < 10; row++) {
+                for (int col = 2; col < 10; col++) {
+                    if ((row == 2 || row == 9) && (col > 3 && col < 8)) {
+                        glyph.set(row, col);
+                    } else if ((col == 2 || col == 9) && (row > 3 && row < 8)) {
+                        glyph.set(row, col);
+                    } else if ((row == 3 || row == 8) && (col == 3 || col == 8)) {
+                        glyph.set(row, col);
+                    }
+                }
+            }
+            break;
+        case '1': case 'I': case 'l':
+            // Draw I/1 shape
+            for (int row = 1; row < 11; row++) {
+                glyph.set(row, 5);
+                glyph.set(row, 6);
+            }
+            // Add serifs for better visibility
+            for (int col = 4; col < 8; col++) {
+                glyph.set(1, col); // top
+                glyph.set(10, col); // bottom
+            }
+            break;
+        case '2':
+            // Draw 2 shape
+            for (int col = 2; col < 9; col++) {
+                glyph.set(2, col); // top
+                glyph.set(6, col); // middle
+                glyph.set(10, col); // bottom
+            }
+            // Right side top
+            for (int row = 3; row < 6; row++) {
+                glyph.set(row, 8);
+            }
+            // Left side bottom
+            for (int row = 7; row < 10; row++) {
+                glyph.set(row, 2);
+            }
+            break;
+        case '3':
+            // Draw 3 shape
+            for (int col = 2; col < 8; col++) {
+                glyph.set(2, col); // top
+                glyph.set(6, col); // middle
+                glyph.set(10, col); // bottom
+            }
+            for (int row = 3; row < 10; row++) {
+                if (row != 6) glyph.set(row, 8); // right side
+            }
+            break;
+        case '4':
+            // Draw 4 shape
+            for (int row = 2; row < 7; row++) {
+                glyph.set(row, 2); // left side
+            }
+            for (int col = 2; col < 9; col++) {
+                glyph.set(6, col); // middle
+            }
+            for (int row = 2; row < 11; row++) {
+                glyph.set(row, 8); // right side
+            }
+            break;
+        case '5': case 'S': 
+            // Draw 5/S shape
+            for (int col = 2; col < 8; col++) {
+                glyph.set(2, col); // top
+                glyph.set(6, col); // middle
+                glyph.set(10, col); // bottom
+            }
+            for (int row = 3; row < 6; row++) {
+                glyph.set(row, 2); // left side top
+            }
+            for (int row = 7; row < 10; row++) {
+                glyph.set(row, 8); // right side bottom
+            }
+            break;
+        case '6':
+            // Draw 6 shape (enhanced for 12x12)
+            for (int col = 2; col < 8; col++) {
+                glyph.set(2, col); // top
+                glyph.set(6, col); // middle
+                glyph.set(10, col); // bottom
+            }
+            for (int row = 3; row < 10; row++) {
+                glyph.set(row, 2); // left side
+            }
+            for (int row = 7; row < 10; row++) {
+                glyph.set(row, 8); // right side bottom
+            }
+            break;
+        case '7':
+            // Draw 7 shape  
+            for (int col = 2; col < 9; col++) {
+                glyph.set(2, col); // top
+            }
+            for (int row = 3; row < 11; row++) {
+                glyph.set(row, 8); // right side
+            }
+            break;
+        case '8':
+            // Draw 8 shape (enhanced)
+            for (int col = 2; col < 8; col++) {
+                glyph.set(2, col); // top
+                glyph.set(6, col); // middle
+                glyph.set(10, col); // bottom
+            }
+            for (int row = 3; row < 10; row++) {
+                if (row != 6) {
+                    glyph.set(row, 2); // left side
+                    glyph.set(row, 8); // right side
+                }
+            }
+            break;
+        case '9':
+            // Draw 9 shape (enhanced)
+            for (int col = 2; col < 8; col++) {
+                glyph.set(2, col); // top
+                glyph.set(6, col); // middle
+                glyph.set(10, col); // bottom
+            }
+            for (int row = 3; row < 6; row++) {
+                glyph.set(row, 2); // left side top
+            }
+            for (int row = 3; row < 10; row++) {
+                glyph.set(row, 8); // right side
+            }
+            break;
+        case 'T': case 't':
+            // Draw T shape (enhanced)
+            for (int col = 1; col < 10; col++) {
+                glyph.set(2, col); // top
+            }
+            for (int row = 3; row < 11; row++) {
+                glyph.set(row, 5); // center vertical
+                glyph.set(row, 6);
+            }
+            break;
+        case 'M': case 'm':
+            // Draw M shape (enhanced)
+            for (int row = 2; row < 11; row++) {
+                glyph.set(row, 1); // left
+                glyph.set(row, 9); // right
+            }
+            // Middle peaks  
+            glyph.set(3, 3);
+            glyph.set(3, 7);
+            glyph.set(4, 4);
+            glyph.set(4, 6);
+            glyph.set(5, 5);
+            break;
+        case 'E': case 'e':
+            // Draw E shape (enhanced)
+            for (int row = 2; row < 11; row++) {
+                glyph.set(row, 2); // left side
+            }
+            for (int col = 2; col < 8; col++) {
+                glyph.set(2, col); // top
+                glyph.set(6, col); // middle
+                glyph.set(10, col); // bottom
+            }
+            break;
+        case 'V': case 'v':
+            // Draw V shape (enhanced)
+            for (int row = 2; row < 7; row++) {
+                glyph.set(row, 2); // left
+                glyph.set(row, 8); // right
+            }
+            glyph.set(7, 3);
+            glyph.set(7, 7);
+            glyph.set(8, 4);
+            glyph.set(8, 6);
+            glyph.set(9, 5);
+            break;
+        case 'C': case 'c':
+            // Draw C shape (enhanced)
+            for (int col = 3; col < 8; col++) {
+                glyph.set(2, col); // top
+                glyph.set(10, col); // bottom
+            }
+            for (int row = 3; row < 10; row++) {
+                glyph.set(row, 2); // left side
+            }
+            break;
+        case 'R': case 'r':
+            // Draw R shape (enhanced)
+            for (int row = 2; row < 11; row++) {
+                glyph.set(row, 2); // left side
+            }
+            for (int col = 2; col < 7; col++) {
+                glyph.set(2, col); // top
+                glyph.set(6, col); // middle
+            }
+            for (int row = 3; row < 6; row++) {
+                glyph.set(row, 7); // right side top
+            }
+            // Diagonal leg
+            glyph.set(7, 5);
+            glyph.set(8, 6);
+            glyph.set(9, 7);
+            glyph.set(10, 8);
+            break;
+        case 'Y': case 'y':
+            // Draw Y shape (enhanced)
+            glyph.set(2, 2); // top left
+            glyph.set(2, 8); // top right
+            glyph.set(3, 3); // converging
+            glyph.set(3, 7);
+            glyph.set(4, 4);
+            glyph.set(4, 6);
+            for (int row = 5; row < 11; row++) {
+                glyph.set(row, 5); // center vertical
+            }
+            break;
+        case 'U': case 'u':
+            // Draw U shape (enhanced)
+            for (int row = 2; row < 9; row++) {
+                glyph.set(row, 2); // left side
+                glyph.set(row, 8); // right side
+            }
+            for (int col = 3; col < 8; col++) {
+                glyph.set(9, col); // bottom
+                glyph.set(10, col);
+            }
+            break;
+        case 'W': case 'w':
+            // Draw W shape (enhanced)
+            for (int row = 2; row < 9; row++) {
+                glyph.set(row, 1); // left
+                glyph.set(row, 9); // right
+            }
+            glyph.set(7, 5); // middle peak
+            glyph.set(8, 3); // middle supports
+            glyph.set(8, 7);
+            glyph.set(9, 4);
+            glyph.set(9, 6);
+            glyph.set(10, 5); // bottom center
+            break;
+        case 'N': case 'n':
+            // Draw N shape (enhanced)
+            for (int row = 2; row < 11; row++) {
+                glyph.set(row, 2); // left
+                glyph.set(row, 8); // right
+                if (row > 2 && row < 10) {
+                    int diagCol = 2 + (row - 2);
+                    if (diagCol < 8) {
+                        glyph.set(row, diagCol); // diagonal
+                    }
+                }
+            }
+            break;
+        case ':':
+            // Draw colon (enhanced)
+            glyph.set(4, 5);
+            glyph.set(4, 6);
+            glyph.set(5, 5);
+            glyph.set(5, 6);
+            glyph.set(7, 5);
+            glyph.set(7, 6);
+            glyph.set(8, 5);
+            glyph.set(8, 6);
+            break;
+        case '!':
+            // Draw exclamation mark (enhanced)
+            for (int row = 2; row < 8; row++) {
+                glyph.set(row, 5);
+                glyph.set(row, 6);
+            }
+            glyph.set(9, 5);
+            glyph.set(9, 6);
+            glyph.set(10, 5);
+            glyph.set(10, 6);
+            break;
+        default:
+            // Lowercase shares the capitals; other printable characters use the classic
+            // shapes stretched onto the 7x9 area the hand-drawn glyphs occupy
+            if (c >= 'a' && c <= 'z') {
+                return basicGlyph(static_cast<char>(c - 'a' + 'A'));
+            }
+            if (const char* pattern = classicPattern(c)) {
+                drawPattern(glyph, pattern, {2, 3, 5, 6, 8, 9}, {2, 3, 4, 6, 7, 8, 10, 11});
+                break;
+            }
+            // Draw a small rectangle for unknown characters (enhanced)
+            for (int row = 4; row < 8; row++) {
+                for (int col = 3; col < 8; col++) {
+                    glyph.set(row, col);
+                }
+            }
+            break;
+    }
+    return glyph;
+}
+
+constexpr Glyph<BitmapFont::HUD_SIZE> hudGlyph(char c) {
+    Glyph<BitmapFont::HUD_SIZE> glyph;
+
+    // Enhanced character patterns with complete alphabet support
+    switch (c) {
+        case '0': case 'O': case 'o':
+            for (int row = 3; row < 13; row++) {
+                for (int col = 3; col < 13; col++) {
+                    if ((row == 3 || row == 12) && (col > 4 && col < 11)) {
+                        glyph.set(row, col);
+                    } else if ((col == 3 || col == 12) && (row > 4 && row < 11)) {
+                        glyph.set(row, col);
+                    } else if ((row == 4 || row == 11) && (col == 4 || col == 11)) {
+                        glyph.set(row, col);
+                    }
+                }
+            }
+            break;
+        case '1': case 'I': case 'i':
+            for (int row = 2; row < 14; row++) {
+                glyph.set(row, 7);
+                glyph.set(row, 8);
+            }
+            for (int col = 5; col < 11; col++) {
+                glyph.set(2, col);
+                glyph.set(13, col);
+            }
+            break;
+        case '2':
+            for (int col = 3; col < 12; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 4; row < 8; row++) {
+                glyph.set(row, 11); // right top
+            }
+            for (int row = 9; row < 12; row++) {
+                glyph.set(row, 3);  // left bottom
+            }
+            break;
+        case '3':
+            for (int col = 3; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 4; row < 12; row++) {
+                if (row != 8) glyph.set(row, 11); // right
+            }
+            break;
+        case '4':
+            for (int row = 3; row < 9; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int col = 3; col < 12; col++) {
+                glyph.set(8, col);  // middle
+            }
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 11); // right
+            }
+            break;
+        case '5': case 'S': case 's':
+            for (int col = 3; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 4; row < 8; row++) {
+                glyph.set(row, 3);  // left top
+            }
+            for (int row = 9; row < 12; row++) {
+                glyph.set(row, 11); // right bottom
+            }
+            break;
+        case '6':
+            for (int col = 3; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 4; row < 12; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int row = 9; row < 12; row++) {
+                glyph.set(row, 11); // right bottom
+            }
+            break;
+        case '7':
+            for (int col = 3; col < 12; col++) {
+                glyph.set(3, col);  // top
+            }
+            for (int row = 4; row < 13; row++) {
+                glyph.set(row, 11); // right
+            }
+            break;
+        case '8':
+            for (int col = 3; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 4; row < 12; row++) {
+                if (row != 8) {
+                    glyph.set(row, 3);  // left
+                    glyph.set(row, 11); // right
+                }
+            }
+            break;
+        case '9':
+            for (int col = 3; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 4; row < 8; row++) {
+                glyph.set(row, 3);  // left top
+            }
+            for (int row = 4; row < 12; row++) {
+                glyph.set(row, 11); // right
+            }
+            break;
+        case 'A': case 'a':
+            for (int col = 4; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+            }
+            for (int row = 4; row < 13; row++) {
+                glyph.set(row, 3);  // left
+                glyph.set(row, 11); // right
+            }
+            break;
+        case 'B': case 'b':
+            for (int col = 3; col < 10; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int row = 4; row < 8; row++) {
+                glyph.set(row, 10); // right top
+            }
+            for (int row = 9; row < 12; row++) {
+                glyph.set(row, 10); // right bottom
+            }
+            break;
+        case 'C': case 'c':
+            for (int col = 4; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 4; row < 12; row++) {
+                glyph.set(row, 3);  // left
+            }
+            break;
+        case 'D': case 'd':
+            for (int col = 3; col < 10; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int row = 4; row < 12; row++) {
+                glyph.set(row, 10); // right
+            }
+            glyph.set(4, 11);
+            glyph.set(11, 11);
+            break;
+        case 'E': case 'e':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int col = 3; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+                glyph.set(12, col); // bottom
+            }
+            break;
+        case 'F': case 'f':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int col = 3; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+            }
+            break;
+        case 'G': case 'g':
+            for (int col = 4; col < 11; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(12, col); // bottom
+            }
+            for (int row = 4; row < 12; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int row = 8; row < 12; row++) {
+                glyph.set(row, 11); // right bottom
+            }
+            for (int col = 8; col < 11; col++) {
+                glyph.set(8, col);  // middle bar
+            }
+            break;
+        case 'H': case 'h':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+                glyph.set(row, 11); // right
+            }
+            for (int col = 3; col < 12; col++) {
+                glyph.set(8, col);  // middle
+            }
+            break;
+        case 'J': case 'j':
+            for (int row = 3; row < 11; row++) {
+                glyph.set(row, 11); // right
+            }
+            for (int col = 4; col < 11; col++) {
+                glyph.set(12, col); // bottom
+            }
+            glyph.set(11, 3);
+            break;
+        case 'K': case 'k':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+            }
+            // Diagonal lines
+            glyph.set(5, 7);
+            glyph.set(6, 6);
+            glyph.set(7, 5);
+            glyph.set(8, 6);
+            glyph.set(9, 7);
+            glyph.set(10, 8);
+            glyph.set(4, 8);
+            glyph.set(3, 9);
+            glyph.set(11, 9);
+            glyph.set(12, 10);
+            break;
+        case 'L': case 'l':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int col = 3; col < 11; col++) {
+                glyph.set(12, col); // bottom
+            }
+            break;
+        case 'M': case 'm':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 2);  // left
+                glyph.set(row, 12); // right
+            }
+            // Middle peaks
+            glyph.set(4, 4);
+            glyph.set(4, 10);
+            glyph.set(5, 5);
+            glyph.set(5, 9);
+            glyph.set(6, 6);
+            glyph.set(6, 8);
+            glyph.set(7, 7);
+            break;
+        case 'N': case 'n':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+                glyph.set(row, 11); // right
+                // Diagonal
+                int diagCol = 3 + (row - 3);
+                if (diagCol <= 11) {
+                    glyph.set(row, diagCol);
+                }
+            }
+            break;
+        case 'P': case 'p':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int col = 3; col < 10; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+            }
+            for (int row = 4; row < 8; row++) {
+                glyph.set(row, 10); // right top
+            }
+            break;
+        case 'Q': case 'q':
+            for (int col = 4; col < 10; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(11, col); // bottom
+            }
+            for (int row = 4; row < 11; row++) {
+                glyph.set(row, 3);  // left
+                glyph.set(row, 10); // right
+            }
+            // Tail
+            glyph.set(10, 9);
+            glyph.set(11, 10);
+            glyph.set(12, 11);
+            break;
+        case 'R': case 'r':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 3);  // left
+            }
+            for (int col = 3; col < 10; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(8, col);  // middle
+            }
+            for (int row = 4; row < 8; row++) {
+                glyph.set(row, 10); // right top
+            }
+            // Diagonal leg
+            glyph.set(9, 6);
+            glyph.set(10, 7);
+            glyph.set(11, 8);
+            glyph.set(12, 9);
+            break;
+        case 'T': case 't':
+            for (int col = 2; col < 13; col++) {
+                glyph.set(3, col);  // top
+            }
+            for (int row = 4; row < 13; row++) {
+                glyph.set(row, 7);  // center
+                glyph.set(row, 8);
+            }
+            break;
+        case 'U': case 'u':
+            for (int row = 3; row < 11; row++) {
+                glyph.set(row, 3);  // left
+                glyph.set(row, 11); // right
+            }
+            for (int col = 4; col < 11; col++) {
+                glyph.set(11, col); // bottom
+                glyph.set(12, col);
+            }
+            break;
+        case 'V': case 'v':
+            for (int row = 3; row < 9; row++) {
+                glyph.set(row, 3);  // left
+                glyph.set(row, 11); // right
+            }
+            glyph.set(9, 4);
+            glyph.set(9, 10);
+            glyph.set(10, 5);
+            glyph.set(10, 9);
+            glyph.set(11, 6);
+            glyph.set(11, 8);
+            glyph.set(12, 7);
+            break;
+        case 'W': case 'w':
+            for (int row = 3; row < 11; row++) {
+                glyph.set(row, 2);  // left
+                glyph.set(row, 12); // right
+            }
+            glyph.set(9, 7);  // center peak
+            glyph.set(10, 4); // left support
+            glyph.set(10, 10); // right support
+            glyph.set(11, 5);
+            glyph.set(11, 6);
+            glyph.set(11, 8);
+            glyph.set(11, 9);
+            glyph.set(12, 7);
+            break;
+        case 'X': case 'x':
+            // Draw X pattern
+            for (int i = 0; i < 10; i++) {
+                glyph.set(3 + i, 3 + i); // main diagonal
+                glyph.set(3 + i, 12 - i); // anti-diagonal
+            }
+            break;
+        case 'Y': case 'y':
+            glyph.set(3, 3);  // top left
+            glyph.set(3, 11); // top right
+            glyph.set(4, 4);  // converging
+            glyph.set(4, 10);
+            glyph.set(5, 5);
+            glyph.set(5, 9);
+            glyph.set(6, 6);
+            glyph.set(6, 8);
+            for (int row = 7; row < 13; row++) {
+                glyph.set(row, 7); // center vertical
+            }
+            break;
+        case 'Z': case 'z':
+            for (int col = 3; col < 12; col++) {
+                glyph.set(3, col);  // top
+                glyph.set(12, col); // bottom
+            }
+            // Diagonal
+            for (int i = 0; i < 9; i++) {
+                glyph.set(4 + i, 11 - i);
+            }
+            break;
+        case ':':
+            glyph.set(5, 7);
+            glyph.set(5, 8);
+            glyph.set(6, 7);
+            glyph.set(6, 8);
+            glyph.set(9, 7);
+            glyph.set(9, 8);
+            glyph.set(10, 7);
+            glyph.set(10, 8);
+            break;
+        case '!':
+            for (int row = 3; row < 10; row++) {
+                glyph.set(row, 7);
+                glyph.set(row, 8);
+            }
+            glyph.set(11, 7);
+            glyph.set(11, 8);
+            glyph.set(12, 7);
+            glyph.set(12, 8);
+            break;
+        case '|':
+            for (int row = 3; row < 13; row++) {
+                glyph.set(row, 7);
+                glyph.set(row, 8);
+            }
+            break;
+        default:
+            // Remaining printable characters: the classic shapes at double size
+            if (const char* pattern = classicPattern(c)) {
+                drawPattern(glyph, pattern, {3, 5, 7, 9, 11, 13}, {1, 3, 5, 7, 9, 11, 13, 15});
+                break;
+            }
+            // Improved block for unknown characters
+            for (int row = 5; row < 11; row++) {
+                for (int col = 4; col < 12; col++) {
+                    if (row == 5 || row == 10 || col == 4 || col == 11) {
+                        glyph.set(row, col);
+                    }
+                }
+            }
+            break;
+    }
+    return glyph;
+}
+
+// Lay every ASCII glyph into its cell, flipped so the atlas is bottom row first like
+// OpenGL textures, then fill the solid cell
+template <int Size>
+constexpr BitmapFont::Atlas<Size> makeAtlas(Glyph<Size> (*shape)(char)) {
+    BitmapFont::Atlas<Size> atlas{};
+    const int width = BitmapFont::atlasWidth(Size);
+    for (int code = 0; code < BitmapFont::GLYPH_COUNT; code++) {
+        Glyph<Size> glyph = shape(static_cast<char>(code));
+        int originX = BitmapFont::cellOriginX(Size, code);
+        int originY = BitmapFont::cellOriginY(Size, code);
+        for (int row = 0; row < Size; row++) {
+            for (int col = 0; col < Size; col++) {
+                atlas.coverage[(originY + Size - 1 - row) * width + originX + col] = glyph.pixels[row * Size + col];
+            }
+        }
+    }
+    int solidX = BitmapFont::cellOriginX(Size, BitmapFont::SOLID_CELL);
+    int solidY = BitmapFont::cellOriginY(Size, BitmapFont::SOLID_CELL);
+    for (int row = 0; row < Size; row++) {
+        for (int col = 0; col < Size; col++) {
+            atlas.coverage[(solidY + row) * width + solidX + col] = 255;
+        }
+    }
+    return atlas;
+}
+
+template <int Size>
+constexpr bool cellHasCoverage(const BitmapFont::Atlas<Size>& atlas, int cell) {
+    const int width = BitmapFont::atlasWidth(Size);
+    int originX = BitmapFont::cellOriginX(Size, cell);
+    int originY = BitmapFont::cellOriginY(Size, cell);
+    for (int row = 0; row < Size; row++) {
+        for (int col = 0; col < Size; col++) {
+            if (atlas.coverage[(originY + row) * width + originX + col] != 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <int Size>
+constexpr bool cellsEqual(const BitmapFont::Atlas<Size>& atlas, int a, int b) {
+    const int width = BitmapFont::atlasWidth(Size);
+    for (int row = 0; row < Size; row++) {
+        for (int col = 0; col < Size; col++) {
+            if (atlas.coverage[(BitmapFont::cellOriginY(Size, a) + row) * width + BitmapFont::cellOriginX(Size, a) + col] !=
+                atlas.coverage[(BitmapFont::cellOriginY(Size, b) + row) * width + BitmapFont::cellOriginX(Size, b) + col]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Every printable ASCII character must have its own glyph, not the unknown-character
+// block that the default branch draws (a control character never has a glyph). The
+// renderer skips spaces.
+template <int Size>
+constexpr bool printableGlyphsExist(const BitmapFont::Atlas<Size>& atlas) {
+    for (int code = '!'; code <= '~'; code++) {
+        if (cellsEqual(atlas, code, '\x01')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr BitmapFont::Atlas<BitmapFont::BASIC_SIZE> BASIC_ATLAS = makeAtlas<BitmapFont::BASIC_SIZE>(basicGlyph);
+constexpr BitmapFont::Atlas<BitmapFont::HUD_SIZE> HUD_ATLAS = makeAtlas<BitmapFont::HUD_SIZE>(hudGlyph);
+
+static_assert(printableGlyphsExist(BASIC_ATLAS), "basic font is missing a printable ASCII glyph");
+static_assert(printableGlyphsExist(HUD_ATLAS), "HUD font is missing a printable ASCII glyph");
+static_assert(cellHasCoverage(HUD_ATLAS, BitmapFont::SOLID_CELL), "HUD font has no solid cell");
+
+} // namespace
+
+// Constant-initialized from the tables above; nothing is generated at startup
+const BitmapFont::Atlas<BitmapFont::BASIC_SIZE> BitmapFont::BASIC = BASIC_ATLAS;
+const BitmapFont::Atlas<BitmapFont::HUD_SIZE> BitmapFont::HUD = HUD_ATLAS;
@@ -0,0 +1,83 @@
+#include "BoardView.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+bool sameInstances(const std::vector<CardInstance>& a, const std::vector<CardInstance>& b) {
+    return a.size() == b.size() &&
+           (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(CardInstance)) == 0);
+}
+
+} // namespace
+
+BoardView::BoardView() : deal(0), dealReady(false) {
+}
+
+std::vector<int> BoardView::getShownFaces(const std::vector<CardInstance>& resting,
+                                          const std::vector<CardInstance>& animated) {
+    std::vector<int> layers;
+    for (const std::vector<CardInstance>* instances : {&resting, &animated}) {
+        for (const CardInstance& instance : *instances) {
+            if (instance.showFront && std::find(layers.begin(), layers.end(), instance.layer) == layers.end()) {
+                layers.push_back(instance.layer);
+            }
+        }
+    }
+    return layers;
+}
+
+void BoardView::render(const FrameSnapshot& snapshot, Renderer* renderer) {
+    if (!renderer) {
+        return;
+    }
+    
+    // Set up the deck's atlas once per deal (unless the shader draws faces); the
+    // renderer drops it when the texture format changes
+    if (!renderer->getProceduralFaces()) {
+        if (!dealReady || snapshot.deal != deal || renderer->getCardAtlas() == 0) {
+            renderer->buildCardAtlas(snapshot.faces);
+            deal = snapshot.deal;
+            dealReady = true;
+        }
+        
+        // Start faces the player is likely to flip, and finish any face already showing
+        for (int layer : snapshot.requestedFaces) {
+            renderer->requestCardFace(layer);
+        }
+        for (int layer : getShownFaces(snapshot.resting, snapshot.animated)) {
+            renderer->finishCardFace(layer);
+        }
+    }
+    renderer->uploadReadyCardFaces();
+    
+    // Each layer is invalidated only when the instances or text it would draw change
+    if (!sameInstances(snapshot.resting, drawnResting)) {
+        renderer->markLayerDirty(Renderer::Layer::BOARD);
+        drawnResting = snapshot.resting;
+    }
+    if (!sameInstances(snapshot.animated, drawnAnimated)) {
+        renderer->markLayerDirty(Renderer::Layer::ANIMATION);
+        drawnAnimated = snapshot.animated;
+    }
+    if (snapshot.hud != drawnHud) {
+        renderer->markLayerDirty(Renderer::Layer::HUD);
+        drawnHud = snapshot.hud;
+    }
+    
+    // Each layer is one instanced draw (or one sprite batch); clean layers are not touched
+    if (renderer->beginLayer(Renderer::Layer::BOARD)) {
+        renderer->drawCards(snapshot.resting);
+        renderer->endLayer();
+    }
+    if (renderer->beginLayer(Renderer::Layer::ANIMATION)) {
+        renderer->drawCards(snapshot.animated);
+        renderer->endLayer();
+    }
+    if (renderer->beginLayer(Renderer::Layer::HUD)) {
+        for (const HudLine& line : snapshot.hud) {
+            renderer->renderEnhancedText(line.text, line.x, line.y, line.scale);
+        }
+        renderer->endLayer();
+    }
+}
@@ -0,0 +1,297 @@
+#include "BoardWall.h"
+#include "BoardView.h"
+#include "InputManager.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace {
+
+bool sameInstances(const std::vector<CardInstance>& a, const std::vector<CardInstance>& b) {
+    return a.size() == b.size() &&
+           (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(CardInstance)) == 0);
+}
+
+// Longest HUD line a tile must hold, in characters ("S:1000 M:999")
+const int HUD_LINE_CHARS = 12;
+
+} // namespace
+
+BoardWall::BoardWall() : numPairs(0), columns(1), rows(1), atlasBuilt(false) {
+}
+
+void BoardWall::initialize(int boardCount, int pairs, int width, int height) {
+    numPairs = pairs;
+    boardCount = std::max(1, boardCount);
+    boards.clear();
+    for (int i = 0; i < boardCount; i++) {
+        boards.push_back(std::make_unique<GameManager>());
+        boards.back()->initialize(numPairs);
+    }
+    snapshots.assign(boards.size(), FrameSnapshot());
+    atlasDeals.assign(boards.size(), 0);
+    wallLayers.assign(boards.size(), std::vector<int>());
+    atlasBuilt = false;
+    drawnResting.assign(boards.size(), std::vector<CardInstance>());
+    drawnAnimated.assign(boards.size(), std::vector<CardInstance>());
+    drawnHud.assign(boards.size(), HudLine());
+
+    // The grid whose tiles come out largest in this window
+    float aspect = static_cast<float>(width) / static_cast<float>(height);
+    float bestScale = 0.0f;
+    for (int cols = 1; cols <= boardCount; cols++) {
+        int rowsNeeded = (boardCount + cols - 1) / cols;
+        float scale = std::min(aspect / (cols * TILE_WIDTH), 1.0f / (rowsNeeded * TILE_HEIGHT));
+        if (scale > bestScale) {
+            bestScale = scale;
+            columns = cols;
+            rows = rowsNeeded;
+        }
+    }
+}
+
+void BoardWall::reset() {
+    for (auto& board : boards) {
+        board->reset(numPairs);
+    }
+}
+
+void BoardWall::update(float deltaTime) {
+    for (auto& board : boards) {
+        board->update(deltaTime);
+    }
+}
+
+glm::vec2 BoardWall::getBoardOrigin(int board) const {
+    int col = board % columns;
+    int row = board / columns;
+    return glm::vec2((col - (columns - 1) * 0.5f) * TILE_WIDTH,
+                     ((rows - 1) * 0.5f - row) * TILE_HEIGHT + BOARD_OFFSET_Y);
+}
+
+int BoardWall::boardAt(float x, float y) const {
+    float col = std::floor(x / TILE_WIDTH + columns * 0.5f);
+    float row = std::floor(rows * 0.5f - y / TILE_HEIGHT);
+    if (col < 0 || col >= columns || row < 0 || row >= rows) {
+        return -1;
+    }
+    int board = static_cast<int>(row) * columns + static_cast<int>(col);
+    return board < getBoardCount() ? board : -1;
+}
+
+bool BoardWall::handleMouseClick(float x, float y) {
+    int board = boardAt(x, y);
+    if (board < 0) {
+        return false;
+    }
+    glm::vec2 local = glm::vec2(x, y) - getBoardOrigin(board);
+    return boards[board]->handleMouseClick(local.x, local.y);
+}
+
+void BoardWall::handleMouseMove(float x, float y) {
+    int board = boardAt(x, y);
+    if (board >= 0) {
+        glm::vec2 local = glm::vec2(x, y) - getBoardOrigin(board);
+        boards[board]->handleMouseMove(local.x, local.y);
+    }
+}
+
+glm::vec2 BoardWall::getHalfExtent(int width, int height) const {
+    // Fit the whole grid, centered, keeping tiles undistorted
+    float aspect = static_cast<float>(width) / static_cast<float>(height);
+    float halfWidth = columns * TILE_WIDTH * 0.5f;
+    float halfHeight = rows * TILE_HEIGHT * 0.5f;
+    if (halfWidth / halfHeight > aspect) {
+        halfHeight = halfWidth / aspect;
+    } else {
+        halfWidth = halfHeight * aspect;
+    }
+    return glm::vec2(halfWidth, halfHeight);
+}
+
+glm::mat4 BoardWall::getProjection(int width, int height) const {
+    glm::vec2 half = getHalfExtent(width, height);
+    return glm::ortho(-half.x, half.x, -half.y, half.y, -100.0f, 100.0f);
+}
+
+glm::vec2 BoardWall::screenToWall(glm::vec2 screenPos, int width, int height) const {
+    return InputManager::screenToWorld(screenPos, getProjection(width, height), width, height);
+}
+
+int BoardWall::getBoardsWon() const {
+    int won = 0;
+    for (const auto& board : boards) {
+        if (board->isGameWon()) {
+            won++;
+        }
+    }
+    return won;
+}
+
+bool BoardWall::needsContinuousFrames() const {
+    for (const auto& board : boards) {
+        if (board->needsContinuousFrames()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float BoardWall::getSecondsUntilClockTick() const {
+    // The tiles show no clock; only input changes an idle wall
+    return 1.0f;
+}
+
+bool BoardWall::assignWallLayers() {
+    bool dealt = false;
+    for (size_t i = 0; i < boards.size(); i++) {
+        dealt = dealt || snapshots[i].deal != atlasDeals[i];
+    }
+    if (!dealt && !wallFaces.empty()) {
+        return false;
+    }
+
+    // One atlas layer per face used anywhere on the wall. Each board numbered its own
+    // faces the same way, so its layers map onto the wall's through its faces.
+    wallFaces.clear();
+    for (const FrameSnapshot& snapshot : snapshots) {
+        wallFaces.insert(wallFaces.end(), snapshot.faces.begin(), snapshot.faces.end());
+    }
+    std::vector<int> layers = Renderer::assignCardLayers(wallFaces);
+    size_t first = 0;
+    for (size_t i = 0; i < boards.size(); i++) {
+        const FrameSnapshot& snapshot = snapshots[i];
+        std::vector<int> boardLayers = Renderer::assignCardLayers(snapshot.faces);
+        std::vector<int>& map = wallLayers[i];
+        map.assign(boardLayers.empty() ? 1 : *std::max_element(boardLayers.begin(), boardLayers.end()) + 1,
+                   Renderer::CARD_BACK_LAYER);
+        for (size_t card = 0; card < boardLayers.size(); card++) {
+            map[boardLayers[card]] = layers[first + card];
+        }
+        first += snapshot.faces.size();
+        atlasDeals[i] = snapshot.deal;
+    }
+    return true;
+}
+
+void BoardWall::buildHud(int width, int height) {
+    // One line per tile along its top edge, scaled down with the tiles. The glyph
+    // metrics follow Renderer::renderEnhancedText.
+    glm::mat4 projection = getProjection(width, height);
+    float tileWidth = TILE_WIDTH * projection[0][0];  // In normalized device coordinates
+    float baseSize = std::min(width, height) / 40.0f;
+    float charWidth = baseSize / width * 2.0f;
+    float scale = std::min(1.0f, 0.9f * tileWidth / (HUD_LINE_CHARS * charWidth * 1.2f));
+    float charHeight = baseSize * scale * 1.4f / height * 2.0f;
+
+    hud.clear();
+    for (int i = 0; i < getBoardCount(); i++) {
+        const GameManager& board = *boards[i];
+        glm::vec2 origin = getBoardOrigin(i) - glm::vec2(0.0f, BOARD_OFFSET_Y);
+        glm::vec4 topLeft = projection * glm::vec4(origin.x - TILE_WIDTH * 0.45f, origin.y + TILE_HEIGHT * 0.47f, 0.0f, 1.0f);
+        std::string text = board.isGameWon() ? "WON " + std::to_string(board.getScore())
+                                             : "S:" + std::to_string(board.getScore()) + " M:" + std::to_string(board.getMoves());
+        hud.push_back({text, topLeft.x, topLeft.y - charHeight, scale});
+    }
+}
+
+void BoardWall::markTileDirty(Renderer* renderer, Renderer::Layer layer, int board, int width, int height) const {
+    // The tile's window pixels, rounded outwards
+    glm::mat4 projection = getProjection(width, height);
+    glm::vec2 center = getBoardOrigin(board) - glm::vec2(0.0f, BOARD_OFFSET_Y);
+    glm::vec4 low = projection * glm::vec4(center.x - TILE_WIDTH * 0.5f, center.y - TILE_HEIGHT * 0.5f, 0.0f, 1.0f);
+    glm::vec4 high = projection * glm::vec4(center.x + TILE_WIDTH * 0.5f, center.y + TILE_HEIGHT * 0.5f, 0.0f, 1.0f);
+    int x0 = static_cast<int>(std::floor((low.x + 1.0f) * 0.5f * width)) - 1;
+    int y0 = static_cast<int>(std::floor((low.y + 1.0f) * 0.5f * height)) - 1;
+    int x1 = static_cast<int>(std::ceil((high.x + 1.0f) * 0.5f * width)) + 1;
+    int y1 = static_cast<int>(std::ceil((high.y + 1.0f) * 0.5f * height)) + 1;
+    renderer->markLayerRegionDirty(layer, x0, y0, x1 - x0, y1 - y0);
+}
+
+void BoardWall::render(Renderer* renderer, int width, int height) {
+    if (!renderer) {
+        return;
+    }
+    for (size_t i = 0; i < boards.size(); i++) {
+        boards[i]->publish(snapshots[i]);
+    }
+    bool dealt = assignWallLayers();
+
+    // One atlas for every board (unless the shader draws faces); the renderer drops it
+    // when the texture format changes
+    if (!renderer->getProceduralFaces()) {
+        if (dealt || !atlasBuilt || renderer->getCardAtlas() == 0) {
+            renderer->buildCardAtlas(wallFaces);
+            atlasBuilt = true;
+        }
+        for (size_t i = 0; i < boards.size(); i++) {
+            for (int layer : snapshots[i].requestedFaces) {
+                renderer->requestCardFace(wallLayers[i][layer]);
+            }
+        }
+    }
+
+    // Every board's cards moved into its tile, with wall atlas layers
+    resting.clear();
+    animated.clear();
+    for (size_t i = 0; i < boards.size(); i++) {
+        glm::vec2 origin = getBoardOrigin(static_cast<int>(i));
+        const std::vector<int>& map = wallLayers[i];
+        auto place = [&](const std::vector<CardInstance>& source, std::vector<CardInstance>& target) {
+            for (CardInstance instance : source) {
+                instance.x += origin.x;
+                instance.y += origin.y;
+                instance.layer = map[instance.layer];
+                target.push_back(instance);
+            }
+        };
+        place(snapshots[i].resting, resting);
+        place(snapshots[i].animated, animated);
+    }
+    if (!renderer->getProceduralFaces()) {
+        for (int layer : BoardView::getShownFaces(resting, animated)) {
+            renderer->finishCardFace(layer);
+        }
+    }
+    renderer->uploadReadyCardFaces();
+    buildHud(width, height);
+
+    // Same retained layers as a single board, but only the tiles of boards that changed
+    // are redrawn. A new deal renumbers the wall's atlas layers, which touches every tile.
+    if (dealt) {
+        renderer->markLayerDirty(Renderer::Layer::BOARD);
+        renderer->markLayerDirty(Renderer::Layer::ANIMATION);
+    }
+    for (int i = 0; i < getBoardCount(); i++) {
+        if (!sameInstances(snapshots[i].resting, drawnResting[i])) {
+            markTileDirty(renderer, Renderer::Layer::BOARD, i, width, height);
+            drawnResting[i] = snapshots[i].resting;
+        }
+        if (!sameInstances(snapshots[i].animated, drawnAnimated[i])) {
+            markTileDirty(renderer, Renderer::Layer::ANIMATION, i, width, height);
+            drawnAnimated[i] = snapshots[i].animated;
+        }
+        if (!(hud[i] == drawnHud[i])) {
+            markTileDirty(renderer, Renderer::Layer::HUD, i, width, height);
+            drawnHud[i] = hud[i];
+        }
+    }
+
+    // The whole wall is one instanced draw per card layer and one sprite batch for the HUD
+    if (renderer->beginLayer(Renderer::Layer::BOARD)) {
+        renderer->drawCards(resting);
+        renderer->endLayer();
+    }
+    if (renderer->beginLayer(Renderer::Layer::ANIMATION)) {
+        renderer->drawCards(animated);
+        renderer->endLayer();
+    }
+    if (renderer->beginLayer(Renderer::Layer::HUD)) {
+        for (const HudLine& line : hud) {
+            renderer->renderEnhancedText(line.text, line.x, line.y, line.scale);
+        }
+        renderer->endLayer();
+    }
+}
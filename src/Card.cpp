@@ -3,30 +3,20 @@
 #include <iostream>
 #include <cmath>
 
-const float CARD_WIDTH = 80.0f;
-const float CARD_HEIGHT = 120.0f;
+const float CARD_WIDTH = Card::WIDTH;
+const float CARD_HEIGHT = Card::HEIGHT;
 const float FLIP_SPEED = 720.0f; // degrees per second
 
 Card::Card(int cardId, int cardRank, int cardSuit) 
     : id(cardId), rank(cardRank), suit(cardSuit), state(CardState::FACE_DOWN),
       position(0.0f, 0.0f), targetPosition(0.0f, 0.0f), angleY(0.0f),
       flipProgress(0.0f), flipSpeed(FLIP_SPEED), isFlipping(false),
-      frontTexture(0), backTexture(0) {
-    
-    // Create front texture (detailed card design)
-    frontTexture = createDetailedCardTexture(rank, suit, true);
-    
-    // Create back texture (decorative pattern)
-    backTexture = createDetailedCardTexture(rank, suit, false);
+      faceLayer(Renderer::CARD_BACK_LAYER) {
+    // Face pixels live in the renderer's shared card atlas; the layer is
+    // assigned once the deck's faces have been uploaded
 }
 
 Card::~Card() {
-    if (frontTexture != 0) {
-        glDeleteTextures(1, &frontTexture);
-    }
-    if (backTexture != 0) {
-        glDeleteTextures(1, &backTexture);
-    }
 }
 
 void Card::update(float deltaTime) {
@@ -65,56 +55,43 @@ void Card::update(float deltaTime) {
     }
 }
 
-void Card::draw(GLuint shaderProgram, glm::mat4 viewMatrix, glm::mat4 projMatrix) {
-    glUseProgram(shaderProgram);
-    
-    // Calculate model matrix
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(position.x, position.y, 0.0f));
-    model = glm::rotate(model, glm::radians(angleY), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::scale(model, glm::vec3(CARD_WIDTH, CARD_HEIGHT, 1.0f));
-    
-    // Set uniforms
-    GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
-    GLint viewLoc = glGetUniformLocation(shaderProgram, "view");
-    GLint projLoc = glGetUniformLocation(shaderProgram, "projection");
+CardInstance Card::getInstance() const {
+    // Determine which side is showing (the atlas itself is bound once per board)
+    bool showFront = (state == CardState::FACE_UP || state == CardState::MATCHED ||
+                      (isFlipping && angleY >= 90.0f && state == CardState::FLIPPING_TO_FACE_UP));
     
-    if (modelLoc >= 0) glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
-    if (viewLoc >= 0) glUniformMatrix4fv(viewLoc, 1, GL_FALSE, &viewMatrix[0][0]);
-    if (projLoc >= 0) glUniformMatrix4fv(projLoc, 1, GL_FALSE, &projMatrix[0][0]);
+    CardInstance instance;
+    instance.x = position.x;
+    instance.y = position.y;
+    instance.angleY = angleY;
+    instance.layer = showFront ? faceLayer : Renderer::CARD_BACK_LAYER;
+    instance.showFront = showFront ? 1 : 0;
     
-    // Determine which texture to use
-    GLuint textureToUse = backTexture;
-    if (state == CardState::FACE_UP || state == CardState::MATCHED ||
-        (isFlipping && angleY >= 90.0f && state == CardState::FLIPPING_TO_FACE_UP)) {
-        textureToUse = frontTexture;
-    }
-    
-    // Bind texture and set uniform
-    if (textureToUse != 0) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureToUse);
-        GLint texLoc = glGetUniformLocation(shaderProgram, "cardTexture");
-        if (texLoc >= 0) glUniform1i(texLoc, 0);
-    }
-    
-    // We need to access the renderer's VAO to actually draw
-    // This is a temporary fix - ideally we'd pass the renderer or VAO
-    extern GLuint g_cardVAO; // We'll define this in the renderer
-    if (g_cardVAO != 0) {
-        glBindVertexArray(g_cardVAO);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
-    }
+    // Ids for the procedural shader path; ignored when sampling the atlas
+    instance.rank = rank;
+    instance.suit = suit;
+    PatternColor color = patternColor((rank + suit * 13) % 16);
+    instance.patternColor[0] = color.r;
+    instance.patternColor[1] = color.g;
+    instance.patternColor[2] = color.b;
+    instance.patternColor[3] = 255;
+    return instance;
 }
 
 void Card::onClick() {
     if (state == CardState::FACE_DOWN && !isFlipping) {
+        prepareFace(); // Generate during the first half of the flip
         startFlip();
         state = CardState::FLIPPING_TO_FACE_UP;
     }
 }
 
+void Card::prepareFace() {
+    if (faceRequest) {
+        faceRequest(faceLayer);
+    }
+}
+
 void Card::startFlip() {
     isFlipping = true;
     flipProgress = 0.0f;
@@ -142,37 +119,128 @@ bool Card::matches(const Card& other) const {
     return (rank == other.rank && suit == other.suit && id != other.id);
 }
 
-GLuint Card::createDetailedCardTexture(int rank, int suit, bool isFront) {
-    const int SIZE = 128; // 128x128 for detailed patterns
+// Base colors for different pattern families
+static const PatternColor PATTERN_COLORS[16] = {
+    {220, 50, 50},   // Red
+    {50, 220, 50},   // Green
+    {50, 50, 220},   // Blue
+    {220, 220, 50},  // Yellow
+    {220, 50, 220},  // Magenta
+    {50, 220, 220},  // Cyan
+    {255, 140, 0},   // Orange
+    {150, 75, 200},  // Purple
+    {255, 100, 150}, // Pink
+    {100, 255, 100}, // Light Green
+    {100, 100, 255}, // Light Blue
+    {255, 200, 100}, // Light Orange
+    {200, 100, 255}, // Light Purple
+    {100, 255, 200}, // Mint
+    {255, 255, 100}, // Light Yellow
+    {200, 200, 200}  // Light Gray
+};
+
+PatternColor Card::patternColor(int pattern) {
+    return PATTERN_COLORS[pattern % 16];
+}
+
+bool Card::patternContains(int pattern, int dx, int dy, int dist) {
+    bool drawPattern = false;
+    
+    // Use a larger variety of patterns to ensure uniqueness for 52 different cards
+    switch (pattern) {
+        case 0: // Concentric circles
+            drawPattern = (dist % 400 < 50) && (dist > 100) && (dist < 2500);
+            break;
+        case 1: // Diamond pattern
+            drawPattern = ((abs(dx) + abs(dy)) % 30 < 5) && (abs(dx) + abs(dy) < 50);
+            break;
+        case 2: // Cross pattern
+            drawPattern = (abs(dx) < 8 && abs(dy) < 40) || (abs(dy) < 8 && abs(dx) < 40);
+            break;
+        case 3: // Star pattern
+            drawPattern = (abs(dx) < 3 && abs(dy) < 35) || 
+                         (abs(dy) < 3 && abs(dx) < 35) ||
+                         (abs(dx - dy) < 3 && abs(dx) < 25) ||
+                         (abs(dx + dy) < 3 && abs(dx) < 25);
+            break;
+        case 4: // Spiral pattern
+            {
+                float angle = atan2(dy, dx);
+                float radius = sqrt(dist);
+                drawPattern = (int(angle * 3 + radius * 0.1) % 10) < 2 && radius < 45;
+            }
+            break;
+        case 5: // Triangle pattern
+            drawPattern = (dy > 0) && (abs(dx) < (50 - dy)) && (dy < 45);
+            break;
+        case 6: // Hexagon pattern
+            {
+                float hexDist = abs(dx) + abs(dy * 0.866f + dx * 0.5f) + abs(dy * 0.866f - dx * 0.5f);
+                drawPattern = (hexDist > 30 && hexDist < 40) || (hexDist > 15 && hexDist < 20);
+            }
+            break;
+        case 7: // Flower pattern
+            {
+                float angle = atan2(dy, dx);
+                float radius = sqrt(dist);
+                float petalRadius = 25 + 10 * cos(angle * 6);
+                drawPattern = (radius > petalRadius - 3 && radius < petalRadius + 3) && radius < 45;
+            }
+            break;
+        case 8: // Grid pattern
+            drawPattern = ((dx % 15 < 3) || (dy % 15 < 3)) && (abs(dx) < 40 && abs(dy) < 40);
+            break;
+        case 9: // Waves pattern
+            {
+                float wave = sin(dx * 0.2f) * 8;
+                drawPattern = (abs(dy - wave) < 4) && (abs(dx) < 45);
+            }
+            break;
+        case 10: // Checkerboard
+            drawPattern = ((dx/10 + dy/10) % 2 == 0) && (abs(dx) < 40 && abs(dy) < 40);
+            break;
+        case 11: // Concentric squares
+            {
+                int maxDist = std::max(abs(dx), abs(dy));
+                drawPattern = (maxDist % 12 < 3) && (maxDist > 10) && (maxDist < 45);
+            }
+            break;
+        case 12: // Plus signs
+            drawPattern = ((abs(dx) % 20 < 3 && abs(dy) % 20 < 12) || 
+                         (abs(dy) % 20 < 3 && abs(dx) % 20 < 12)) && 
+                         (abs(dx) < 45 && abs(dy) < 45);
+            break;
+        case 13: // Zigzag pattern
+            {
+                int zigzag = (dx + dy) % 30;
+                drawPattern = (zigzag < 6 || zigzag > 24) && (abs(dx) < 45 && abs(dy) < 45);
+            }
+            break;
+        case 14: // Circular dots
+            {
+                int dotX = ((dx + 60) / 20) * 20 - 60;
+                int dotY = ((dy + 60) / 20) * 20 - 60;
+                int dotDist = (dx - dotX) * (dx - dotX) + (dy - dotY) * (dy - dotY);
+                drawPattern = (dotDist < 25) && (abs(dx) < 45 && abs(dy) < 45);
+            }
+            break;
+        case 15: // Diagonal stripes
+            drawPattern = ((dx - dy) % 15 < 4) && (abs(dx) < 45 && abs(dy) < 45);
+            break;
+    }
+    
+    return drawPattern;
+}
+
+std::vector<unsigned char> Card::createDetailedCardPixels(int rank, int suit, bool isFront) {
+    const int SIZE = TEXTURE_SIZE; // 128x128 for detailed patterns
     std::vector<unsigned char> textureData(SIZE * SIZE * 4); // RGBA
     
     if (isFront) {
         // Create unique pattern based on card's unique ID ensuring each rank-suit combo is unique
         int uniquePatternId = rank + suit * 13; // Creates unique ID: suits 0-3, ranks 1-13
         
-        // Base colors for different pattern families
-        struct PatternColor {
-            unsigned char r, g, b;
-        } patternColors[] = {
-            {220, 50, 50},   // Red
-            {50, 220, 50},   // Green  
-            {50, 50, 220},   // Blue
-            {220, 220, 50},  // Yellow
-            {220, 50, 220},  // Magenta
-            {50, 220, 220},  // Cyan
-            {255, 140, 0},   // Orange
-            {150, 75, 200},  // Purple
-            {255, 100, 150}, // Pink
-            {100, 255, 100}, // Light Green
-            {100, 100, 255}, // Light Blue
-            {255, 200, 100}, // Light Orange
-            {200, 100, 255}, // Light Purple
-            {100, 255, 200}, // Mint
-            {255, 255, 100}, // Light Yellow
-            {200, 200, 200}  // Light Gray
-        };
-        
-        PatternColor mainColor = patternColors[uniquePatternId % 16];
+        PatternColor mainColor = patternColor(uniquePatternId % 16);
         
         for (int y = 0; y < SIZE; y++) {
             for (int x = 0; x < SIZE; x++) {
@@ -204,90 +272,7 @@ GLuint Card::createDetailedCardTexture(int rank, int suit, bool isFront) {
                     int dy = y - centerY;
                     int dist = dx * dx + dy * dy;
                     
-                    bool drawPattern = false;
-                    
-                    // Use a larger variety of patterns to ensure uniqueness for 52 different cards
-                    switch (uniquePatternId % 16) {
-                        case 0: // Concentric circles
-                            drawPattern = (dist % 400 < 50) && (dist > 100) && (dist < 2500);
-                            break;
-                        case 1: // Diamond pattern
-                            drawPattern = ((abs(dx) + abs(dy)) % 30 < 5) && (abs(dx) + abs(dy) < 50);
-                            break;
-                        case 2: // Cross pattern
-                            drawPattern = (abs(dx) < 8 && abs(dy) < 40) || (abs(dy) < 8 && abs(dx) < 40);
-                            break;
-                        case 3: // Star pattern
-                            drawPattern = (abs(dx) < 3 && abs(dy) < 35) || 
-                                         (abs(dy) < 3 && abs(dx) < 35) ||
-                                         (abs(dx - dy) < 3 && abs(dx) < 25) ||
-                                         (abs(dx + dy) < 3 && abs(dx) < 25);
-                            break;
-                        case 4: // Spiral pattern
-                            {
-                                float angle = atan2(dy, dx);
-                                float radius = sqrt(dist);
-                                drawPattern = (int(angle * 3 + radius * 0.1) % 10) < 2 && radius < 45;
-                            }
-                            break;
-                        case 5: // Triangle pattern
-                            drawPattern = (dy > 0) && (abs(dx) < (50 - dy)) && (dy < 45);
-                            break;
-                        case 6: // Hexagon pattern
-                            {
-                                float hexDist = abs(dx) + abs(dy * 0.866f + dx * 0.5f) + abs(dy * 0.866f - dx * 0.5f);
-                                drawPattern = (hexDist > 30 && hexDist < 40) || (hexDist > 15 && hexDist < 20);
-                            }
-                            break;
-                        case 7: // Flower pattern
-                            {
-                                float angle = atan2(dy, dx);
-                                float radius = sqrt(dist);
-                                float petalRadius = 25 + 10 * cos(angle * 6);
-                                drawPattern = (radius > petalRadius - 3 && radius < petalRadius + 3) && radius < 45;
-                            }
-                            break;
-                        case 8: // Grid pattern
-                            drawPattern = ((dx % 15 < 3) || (dy % 15 < 3)) && (abs(dx) < 40 && abs(dy) < 40);
-                            break;
-                        case 9: // Waves pattern
-                            {
-                                float wave = sin(dx * 0.2f) * 8;
-                                drawPattern = (abs(dy - wave) < 4) && (abs(dx) < 45);
-                            }
-                            break;
-                        case 10: // Checkerboard
-                            drawPattern = ((dx/10 + dy/10) % 2 == 0) && (abs(dx) < 40 && abs(dy) < 40);
-                            break;
-                        case 11: // Concentric squares
-                            {
-                                int maxDist = std::max(abs(dx), abs(dy));
-                                drawPattern = (maxDist % 12 < 3) && (maxDist > 10) && (maxDist < 45);
-                            }
-                            break;
-                        case 12: // Plus signs
-                            drawPattern = ((abs(dx) % 20 < 3 && abs(dy) % 20 < 12) || 
-                                         (abs(dy) % 20 < 3 && abs(dx) % 20 < 12)) && 
-                                         (abs(dx) < 45 && abs(dy) < 45);
-                            break;
-                        case 13: // Zigzag pattern
-                            {
-                                int zigzag = (dx + dy) % 30;
-                                drawPattern = (zigzag < 6 || zigzag > 24) && (abs(dx) < 45 && abs(dy) < 45);
-                            }
-                            break;
-                        case 14: // Circular dots
-                            {
-                                int dotX = ((dx + 60) / 20) * 20 - 60;
-                                int dotY = ((dy + 60) / 20) * 20 - 60;
-                                int dotDist = (dx - dotX) * (dx - dotX) + (dy - dotY) * (dy - dotY);
-                                drawPattern = (dotDist < 25) && (abs(dx) < 45 && abs(dy) < 45);
-                            }
-                            break;
-                        case 15: // Diagonal stripes
-                            drawPattern = ((dx - dy) % 15 < 4) && (abs(dx) < 45 && abs(dy) < 45);
-                            break;
-                    }
+                    bool drawPattern = patternContains(uniquePatternId % 16, dx, dy, dist);
                     
                     if (drawPattern) {
                         textureData[index + 0] = mainColor.r;
@@ -400,16 +385,5 @@ GLuint Card::createDetailedCardTexture(int rank, int suit, bool isFront) {
         }
     }
     
-    // Create and upload texture
-    GLuint texture;
-    glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SIZE, SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, textureData.data());
-    
-    return texture;
-}
\ No newline at end of file
+    return textureData;
+}
@@ -0,0 +1,424 @@
+#include "CardRasterizer.h"
+#include "Card.h"
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CARD_RASTER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CARD_RASTER_SSE2 1
+#endif
+
+namespace {
+
+const int SIZE = Card::TEXTURE_SIZE;
+const int CENTER = SIZE / 2;
+
+// Every pattern family stays inside |dx| < 50 and |dy| < 50 of the center,
+// so pattern kernels only visit that box (rows 15..112, lanes 12..115)
+const int PATTERN_EXTENT = 50;
+const int PATTERN_X_BEGIN = 12;
+const int PATTERN_X_END = 116;
+
+// Packed pixel: R, G, B, A in memory order on little-endian targets
+inline uint32_t packRGBA(unsigned int r, unsigned int g, unsigned int b) {
+    return r | (g << 8) | (b << 16) | (255u << 24);
+}
+
+// ---------------------------------------------------------------------------
+// Lane primitives. Each integer lane holds one pixel column; comparisons
+// return all-ones (-1) for true and 0 for false, like the SSE/AVX compares.
+// ---------------------------------------------------------------------------
+#if defined(CARD_RASTER_AVX2)
+
+typedef __m256i VecI;
+typedef __m256 VecF;
+const int LANES = 8;
+
+inline VecI iset(int v) { return _mm256_set1_epi32(v); }
+inline VecI iramp(int start) { return _mm256_add_epi32(_mm256_set1_epi32(start), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)); }
+inline VecI iadd(VecI a, VecI b) { return _mm256_add_epi32(a, b); }
+inline VecI isub(VecI a, VecI b) { return _mm256_sub_epi32(a, b); }
+inline VecI imul(VecI a, VecI b) { return _mm256_mullo_epi32(a, b); }
+inline VecI iand(VecI a, VecI b) { return _mm256_and_si256(a, b); }
+inline VecI ior(VecI a, VecI b) { return _mm256_or_si256(a, b); }
+inline VecI ilt(VecI a, VecI b) { return _mm256_cmpgt_epi32(b, a); }
+inline VecI igt(VecI a, VecI b) { return _mm256_cmpgt_epi32(a, b); }
+inline VecI ieq(VecI a, VecI b) { return _mm256_cmpeq_epi32(a, b); }
+inline VecI iabs(VecI a) { return _mm256_abs_epi32(a); }
+inline VecI imax(VecI a, VecI b) { return _mm256_max_epi32(a, b); }
+inline VecI iselect(VecI mask, VecI a, VecI b) { return _mm256_blendv_epi8(b, a, mask); }
+inline VecF itof(VecI a) { return _mm256_cvtepi32_ps(a); }
+inline VecI ftoi(VecF a) { return _mm256_cvttps_epi32(a); }
+inline VecF fmul(VecF a, float b) { return _mm256_mul_ps(a, _mm256_set1_ps(b)); }
+inline VecI loadPixels(const unsigned char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+inline void storePixels(unsigned char* p, VecI v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+#elif defined(CARD_RASTER_SSE2)
+
+typedef __m128i VecI;
+typedef __m128 VecF;
+const int LANES = 4;
+
+inline VecI iset(int v) { return _mm_set1_epi32(v); }
+inline VecI iramp(int start) { return _mm_setr_epi32(start, start + 1, start + 2, start + 3); }
+inline VecI iadd(VecI a, VecI b) { return _mm_add_epi32(a, b); }
+inline VecI isub(VecI a, VecI b) { return _mm_sub_epi32(a, b); }
+inline VecI iand(VecI a, VecI b) { return _mm_and_si128(a, b); }
+inline VecI ior(VecI a, VecI b) { return _mm_or_si128(a, b); }
+inline VecI ilt(VecI a, VecI b) { return _mm_cmplt_epi32(a, b); }
+inline VecI igt(VecI a, VecI b) { return _mm_cmpgt_epi32(a, b); }
+inline VecI ieq(VecI a, VecI b) { return _mm_cmpeq_epi32(a, b); }
+inline VecI iselect(VecI mask, VecI a, VecI b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+inline VecI imax(VecI a, VecI b) { return iselect(_mm_cmpgt_epi32(a, b), a, b); }
+inline VecI iabs(VecI a) {
+    VecI sign = _mm_srai_epi32(a, 31);
+    return _mm_sub_epi32(_mm_xor_si128(a, sign), sign);
+}
+inline VecF itof(VecI a) { return _mm_cvtepi32_ps(a); }
+inline VecI ftoi(VecF a) { return _mm_cvttps_epi32(a); }
+inline VecF fmul(VecF a, float b) { return _mm_mul_ps(a, _mm_set1_ps(b)); }
+// SSE2 has no 32-bit multiply; products here stay far below 2^24, so float is exact
+inline VecI imul(VecI a, VecI b) { return _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(a), _mm_cvtepi32_ps(b))); }
+inline VecI loadPixels(const unsigned char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void storePixels(unsigned char* p, VecI v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+#else
+
+// Single-lane fallback; wrapped so it cannot be confused with plain ints
+struct VecI { int v; };
+typedef float VecF;
+const int LANES = 1;
+
+inline VecI iset(int v) { return VecI{v}; }
+inline VecI iramp(int start) { return VecI{start}; }
+inline VecI iadd(VecI a, VecI b) { return VecI{a.v + b.v}; }
+inline VecI isub(VecI a, VecI b) { return VecI{a.v - b.v}; }
+inline VecI imul(VecI a, VecI b) { return VecI{a.v * b.v}; }
+inline VecI iand(VecI a, VecI b) { return VecI{a.v & b.v}; }
+inline VecI ior(VecI a, VecI b) { return VecI{a.v | b.v}; }
+inline VecI ilt(VecI a, VecI b) { return VecI{a.v < b.v ? -1 : 0}; }
+inline VecI igt(VecI a, VecI b) { return VecI{a.v > b.v ? -1 : 0}; }
+inline VecI ieq(VecI a, VecI b) { return VecI{a.v == b.v ? -1 : 0}; }
+inline VecI iabs(VecI a) { return VecI{a.v < 0 ? -a.v : a.v}; }
+inline VecI imax(VecI a, VecI b) { return a.v > b.v ? a : b; }
+inline VecI iselect(VecI mask, VecI a, VecI b) { return VecI{(mask.v & a.v) | (~mask.v & b.v)}; }
+inline VecF itof(VecI a) { return static_cast<float>(a.v); }
+inline VecI ftoi(VecF a) { return VecI{static_cast<int>(a)}; }
+inline VecF fmul(VecF a, float b) { return a * b; }
+// Byte-wise so the packed layout does not depend on host endianness
+inline VecI loadPixels(const unsigned char* p) {
+    return VecI{static_cast<int>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24))};
+}
+inline void storePixels(unsigned char* p, VecI v) {
+    uint32_t u = static_cast<uint32_t>(v.v);
+    p[0] = u & 0xFF; p[1] = (u >> 8) & 0xFF; p[2] = (u >> 16) & 0xFF; p[3] = u >> 24;
+}
+
+#endif
+
+inline VecI ilt(VecI a, int b) { return ilt(a, iset(b)); }
+inline VecI igt(VecI a, int b) { return igt(a, iset(b)); }
+inline VecI ieq(VecI a, int b) { return ieq(a, iset(b)); }
+inline VecI ibool(bool b) { return iset(b ? -1 : 0); }
+inline VecI iand(VecI a, VecI b, VecI c) { return iand(iand(a, b), c); }
+
+// C++ truncating division/remainder by a positive constant. The float
+// reciprocal may be one off near exact multiples; the fix-up makes it exact
+// for |a| < 2^22, far beyond anything a 128x128 texture produces.
+inline void idivmod(VecI a, int d, VecI& q, VecI& r) {
+    VecI negative = ilt(a, 0);
+    VecI m = iabs(a);
+    VecI qm = ftoi(fmul(itof(m), 1.0f / d));
+    VecI rm = isub(m, imul(qm, iset(d)));
+    VecI under = ilt(rm, 0);
+    qm = iadd(qm, under);
+    rm = iadd(rm, iand(under, iset(d)));
+    VecI over = igt(rm, d - 1);
+    qm = isub(qm, over);
+    rm = isub(rm, iand(over, iset(d)));
+    q = iselect(negative, isub(iset(0), qm), qm);
+    r = iselect(negative, isub(iset(0), rm), rm);
+}
+inline VecI imod(VecI a, int d) { VecI q, r; idivmod(a, d, q, r); return r; }
+inline VecI idiv(VecI a, int d) { VecI q, r; idivmod(a, d, q, r); return q; }
+
+// ---------------------------------------------------------------------------
+// Pattern kernels: one specialization per family, mirroring the cases of
+// Card::patternContains lane for lane. dy is constant across the row.
+// ---------------------------------------------------------------------------
+template <int Pattern> VecI patternLanes(VecI dx, VecI adx, int dy, int ady);
+
+template <> VecI patternLanes<0>(VecI dx, VecI, int dy, int) { // Concentric circles
+    VecI dist = iadd(imul(dx, dx), iset(dy * dy));
+    return iand(ilt(imod(dist, 400), 50), igt(dist, 100), ilt(dist, 2500));
+}
+template <> VecI patternLanes<1>(VecI, VecI adx, int, int ady) { // Diamond pattern
+    VecI manhattan = iadd(adx, iset(ady));
+    return iand(ilt(imod(manhattan, 30), 5), ilt(manhattan, 50));
+}
+template <> VecI patternLanes<2>(VecI, VecI adx, int, int ady) { // Cross pattern
+    return ior(iand(ilt(adx, 8), ibool(ady < 40)), iand(ibool(ady < 8), ilt(adx, 40)));
+}
+template <> VecI patternLanes<3>(VecI dx, VecI adx, int dy, int ady) { // Star pattern
+    VecI dyv = iset(dy);
+    return ior(ior(iand(ilt(adx, 3), ibool(ady < 35)),
+                   iand(ibool(ady < 3), ilt(adx, 35))),
+               ior(iand(ilt(iabs(isub(dx, dyv)), 3), ilt(adx, 25)),
+                   iand(ilt(iabs(iadd(dx, dyv)), 3), ilt(adx, 25))));
+}
+template <> VecI patternLanes<5>(VecI, VecI adx, int dy, int) { // Triangle pattern
+    return iand(ibool(dy > 0 && dy < 45), ilt(adx, 50 - dy));
+}
+template <> VecI patternLanes<8>(VecI dx, VecI adx, int dy, int ady) { // Grid pattern
+    return iand(ior(ilt(imod(dx, 15), 3), ibool(dy % 15 < 3)), ilt(adx, 40), ibool(ady < 40));
+}
+template <> VecI patternLanes<10>(VecI dx, VecI adx, int dy, int ady) { // Checkerboard
+    VecI cell = iadd(idiv(dx, 10), iset(dy / 10));
+    return iand(ieq(imod(cell, 2), 0), ilt(adx, 40), ibool(ady < 40));
+}
+template <> VecI patternLanes<11>(VecI, VecI adx, int, int ady) { // Concentric squares
+    VecI maxDist = imax(adx, iset(ady));
+    return iand(ilt(imod(maxDist, 12), 3), igt(maxDist, 10), ilt(maxDist, 45));
+}
+template <> VecI patternLanes<12>(VecI, VecI adx, int, int ady) { // Plus signs
+    VecI modX = imod(adx, 20);
+    int modY = ady % 20;
+    VecI plus = ior(iand(ilt(modX, 3), ibool(modY < 12)), iand(ibool(modY < 3), ilt(modX, 12)));
+    return iand(plus, ilt(adx, 45), ibool(ady < 45));
+}
+template <> VecI patternLanes<13>(VecI dx, VecI adx, int dy, int ady) { // Zigzag pattern
+    VecI zigzag = imod(iadd(dx, iset(dy)), 30);
+    return iand(ior(ilt(zigzag, 6), igt(zigzag, 24)), ilt(adx, 45), ibool(ady < 45));
+}
+template <> VecI patternLanes<14>(VecI dx, VecI adx, int dy, int ady) { // Circular dots
+    VecI dotX = isub(imul(idiv(iadd(dx, iset(60)), 20), iset(20)), iset(60));
+    int dotY = ((dy + 60) / 20) * 20 - 60;
+    VecI offX = isub(dx, dotX);
+    VecI dotDist = iadd(imul(offX, offX), iset((dy - dotY) * (dy - dotY)));
+    return iand(ilt(dotDist, 25), ilt(adx, 45), ibool(ady < 45));
+}
+template <> VecI patternLanes<15>(VecI dx, VecI adx, int dy, int ady) { // Diagonal stripes
+    return iand(ilt(imod(isub(dx, iset(dy)), 15), 4), ilt(adx, 45), ibool(ady < 45));
+}
+
+// Families built on atan2/sqrt/sin/cos stay scalar and reuse the reference
+// predicate so rounding matches exactly; they are only culled, not rewritten
+template <int Pattern> struct ScalarPattern { static const bool value = false; static const int maxDist = 0; };
+template <> struct ScalarPattern<4> { static const bool value = true; static const int maxDist = 45 * 45; };
+template <> struct ScalarPattern<6> { static const bool value = true; static const int maxDist = 0; };
+template <> struct ScalarPattern<7> { static const bool value = true; static const int maxDist = 45 * 45; };
+template <> struct ScalarPattern<9> { static const bool value = true; static const int maxDist = 0; };
+
+template <int Pattern>
+void rasterizePattern(unsigned char* rgba, PatternColor color) {
+    for (int dy = 1 - PATTERN_EXTENT; dy < PATTERN_EXTENT; dy++) {
+        unsigned char* row = rgba + (dy + CENTER) * SIZE * 4;
+
+        if constexpr (ScalarPattern<Pattern>::value) {
+            for (int dx = 1 - PATTERN_EXTENT; dx < PATTERN_EXTENT; dx++) {
+                int dist = dx * dx + dy * dy;
+                // radius < 45 in the reference is exactly dist < 2025
+                if (ScalarPattern<Pattern>::maxDist != 0 && dist >= ScalarPattern<Pattern>::maxDist) continue;
+                if (Card::patternContains(Pattern, dx, dy, dist)) {
+                    unsigned char* pixel = row + (dx + CENTER) * 4;
+                    pixel[0] = color.r;
+                    pixel[1] = color.g;
+                    pixel[2] = color.b;
+                }
+            }
+        } else {
+            const VecI mainColor = iset(static_cast<int>(packRGBA(color.r, color.g, color.b)));
+            const int ady = dy < 0 ? -dy : dy;
+            for (int x = PATTERN_X_BEGIN; x < PATTERN_X_END; x += LANES) {
+                VecI dx = iramp(x - CENTER);
+                VecI hit = patternLanes<Pattern>(dx, iabs(dx), dy, ady);
+                unsigned char* pixels = row + x * 4;
+                storePixels(pixels, iselect(hit, mainColor, loadPixels(pixels)));
+            }
+        }
+    }
+}
+
+typedef void (*PatternKernel)(unsigned char*, PatternColor);
+const PatternKernel PATTERN_KERNELS[16] = {
+    &rasterizePattern<0>,  &rasterizePattern<1>,  &rasterizePattern<2>,  &rasterizePattern<3>,
+    &rasterizePattern<4>,  &rasterizePattern<5>,  &rasterizePattern<6>,  &rasterizePattern<7>,
+    &rasterizePattern<8>,  &rasterizePattern<9>,  &rasterizePattern<10>, &rasterizePattern<11>,
+    &rasterizePattern<12>, &rasterizePattern<13>, &rasterizePattern<14>, &rasterizePattern<15>
+};
+
+// Fill pixels [x0, x1) of a row with one color using vector stores
+void fillRun(unsigned char* row, int x0, int x1, uint32_t color) {
+    const VecI value = iset(static_cast<int>(color));
+    unsigned char* pixel = row + x0 * 4;
+    unsigned char* end = row + x1 * 4;
+    for (; pixel + LANES * 4 <= end; pixel += LANES * 4) {
+        storePixels(pixel, value);
+    }
+    for (; pixel < end; pixel += 4) {
+        pixel[0] = color & 0xFF;
+        pixel[1] = (color >> 8) & 0xFF;
+        pixel[2] = (color >> 16) & 0xFF;
+        pixel[3] = color >> 24;
+    }
+}
+
+inline void setRGB(unsigned char* rgba, int x, int y, int r, int g, int b) {
+    unsigned char* pixel = rgba + (y * SIZE + x) * 4;
+    pixel[0] = static_cast<unsigned char>(r);
+    pixel[1] = static_cast<unsigned char>(g);
+    pixel[2] = static_cast<unsigned char>(b);
+}
+
+} // namespace
+
+void CardRasterizer::rasterizeFront(int rank, int suit, unsigned char* rgba) {
+    const uint32_t BLACK = packRGBA(20, 20, 20);
+    const uint32_t GOLD = packRGBA(200, 170, 100);
+    const uint32_t WHITE = packRGBA(250, 250, 250);
+
+    int uniquePatternId = rank + suit * 13;
+    PatternColor mainColor = Card::patternColor(uniquePatternId % 16);
+
+    // Background, black border and gold inner border
+    for (int y = 0; y < SIZE; y++) {
+        unsigned char* row = rgba + y * SIZE * 4;
+        if (y < 3 || y >= SIZE - 3) {
+            fillRun(row, 0, SIZE, BLACK);
+        } else if (y < 6 || y >= SIZE - 6) {
+            fillRun(row, 0, 3, BLACK);
+            fillRun(row, 3, SIZE - 3, GOLD);
+            fillRun(row, SIZE - 3, SIZE, BLACK);
+        } else {
+            fillRun(row, 0, 3, BLACK);
+            fillRun(row, 3, 6, GOLD);
+            fillRun(row, 6, SIZE - 6, WHITE);
+            fillRun(row, SIZE - 6, SIZE - 3, GOLD);
+            fillRun(row, SIZE - 3, SIZE, BLACK);
+        }
+    }
+
+    // Pattern family, with the kernel chosen once per texture
+    PATTERN_KERNELS[((uniquePatternId % 16) + 16) % 16](rgba, mainColor);
+
+    // Rank-specific corner decorations only touch the interior within 20px of a corner
+    for (int y = 6; y < SIZE - 6; y++) {
+        if (y >= 20 && y <= SIZE - 20) continue;
+        for (int x = 6; x < SIZE - 6; x++) {
+            if (x >= 20 && x <= SIZE - 20) continue;
+            if (rank <= 4) {
+                if (((x-15)*(x-15) + (y-15)*(y-15) < 16) ||
+                    ((x-(SIZE-15))*(x-(SIZE-15)) + (y-15)*(y-15) < 16) ||
+                    ((x-15)*(x-15) + (y-(SIZE-15))*(y-(SIZE-15)) < 16) ||
+                    ((x-(SIZE-15))*(x-(SIZE-15)) + (y-(SIZE-15))*(y-(SIZE-15)) < 16)) {
+                    setRGB(rgba, x, y, mainColor.r / 2, mainColor.g / 2, mainColor.b / 2);
+                }
+            } else if (rank <= 8) {
+                if ((x < 20 && (y < 20 || y > SIZE-20)) ||
+                    (x > SIZE-20 && (y < 20 || y > SIZE-20))) {
+                    if ((x + y) % 4 < 2) {
+                        setRGB(rgba, x, y, mainColor.r / 3, mainColor.g / 3, mainColor.b / 3);
+                    }
+                }
+            } else {
+                if ((x < 18 && y < 18) || (x > SIZE-18 && y < 18) ||
+                    (x < 18 && y > SIZE-18) || (x > SIZE-18 && y > SIZE-18)) {
+                    setRGB(rgba, x, y, mainColor.r / 4, mainColor.g / 4, mainColor.b / 4);
+                }
+            }
+        }
+    }
+
+    // Rank indicator (top-left) and suit indicator (bottom-right)
+    for (int y = 0; y < 30; y++) {
+        for (int x = 0; x < 25; x++) {
+            if ((x/3 + y/3) % 13 == ((rank - 1) % 13)) {
+                setRGB(rgba, x, y, 20, 20, 20);
+            }
+        }
+    }
+    for (int y = SIZE - 30; y < SIZE; y++) {
+        for (int x = SIZE - 25; x < SIZE; x++) {
+            if ((x/4 + y/4) % 4 == suit) {
+                setRGB(rgba, x, y, 60, 60, 60);
+            }
+        }
+    }
+}
+
+std::vector<unsigned char> CardRasterizer::rasterize(int rank, int suit, bool isFront) {
+    if (!isFront) {
+        // The shared back is generated once per atlas; the reference is fast enough
+        return Card::createDetailedCardPixels(rank, suit, false);
+    }
+
+    std::vector<unsigned char> pixels(SIZE * SIZE * 4);
+    rasterizeFront(rank, suit, pixels.data());
+    return pixels;
+}
+
+int CardRasterizer::palettize(const unsigned char* rgba, unsigned char* indices, unsigned char* palette) {
+    // Small open-addressed table from packed color to palette index
+    const int TABLE_SIZE = 1024;
+    uint32_t keys[TABLE_SIZE];
+    int slots[TABLE_SIZE];
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        slots[i] = -1;
+    }
+    
+    int colorCount = 0;
+    for (int i = 0; i < SIZE * SIZE; i++) {
+        const unsigned char* pixel = rgba + i * 4;
+        uint32_t key = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16) | (static_cast<uint32_t>(pixel[3]) << 24);
+        int slot = static_cast<int>((key * 2654435761u) >> 22);
+        while (slots[slot] >= 0 && keys[slot] != key) {
+            slot = (slot + 1) & (TABLE_SIZE - 1);
+        }
+        if (slots[slot] < 0) {
+            if (colorCount < PALETTE_SIZE) {
+                keys[slot] = key;
+                slots[slot] = colorCount;
+                for (int c = 0; c < 4; c++) {
+                    palette[colorCount * 4 + c] = pixel[c];
+                }
+                colorCount++;
+            } else {
+                // Palette full: fall back to the closest existing entry (never happens for our faces)
+                int best = 0;
+                int bestDistance = 1 << 30;
+                for (int p = 0; p < PALETTE_SIZE; p++) {
+                    int distance = 0;
+                    for (int c = 0; c < 4; c++) {
+                        int d = pixel[c] - palette[p * 4 + c];
+                        distance += d * d;
+                    }
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = p;
+                    }
+                }
+                indices[i] = static_cast<unsigned char>(best);
+                continue;
+            }
+        }
+        indices[i] = static_cast<unsigned char>(slots[slot]);
+    }
+    
+    // Unused entries stay defined so the palette can be uploaded as a whole row
+    for (int i = colorCount * 4; i < PALETTE_SIZE * 4; i++) {
+        palette[i] = 0;
+    }
+    return colorCount;
+}
+
+const char* CardRasterizer::getInstructionSet() {
+#if defined(CARD_RASTER_AVX2)
+    return "AVX2";
+#elif defined(CARD_RASTER_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,210 @@
+#include "CardTextureCache.h"
+#include "Card.h"
+#include "CardRasterizer.h"
+#include "WorkerPool.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <future>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Fixed-size header at the start of the file; layers follow immediately
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t textureSize;
+    uint32_t layerCount;
+    uint32_t headerSize;
+};
+
+const char CACHE_MAGIC[8] = {'C', 'A', 'R', 'D', 'T', 'E', 'X', '\0'};
+const size_t LAYER_BYTES = static_cast<size_t>(Card::TEXTURE_SIZE) * Card::TEXTURE_SIZE * 4;
+
+size_t expectedFileSize() {
+    return sizeof(CacheHeader) + LAYER_BYTES * CardTextureCache::LAYER_COUNT;
+}
+
+} // namespace
+
+CardTextureCache::CardTextureCache() : mapped(nullptr), mappedSize(0),
+#ifdef _WIN32
+                                       fileHandle(nullptr), mappingHandle(nullptr) {
+#else
+                                       fileDescriptor(-1) {
+#endif
+}
+
+CardTextureCache::~CardTextureCache() {
+    close();
+}
+
+bool CardTextureCache::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || static_cast<size_t>(fileSize.QuadPart) != expectedFileSize()) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mapped = static_cast<const unsigned char*>(view);
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != expectedFileSize()) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    fileDescriptor = fd;
+    mapped = static_cast<const unsigned char*>(view);
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+
+    // Reject caches from another generator version or texture size
+    CacheHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != static_cast<uint32_t>(Card::TEXTURE_VERSION) ||
+        header.textureSize != static_cast<uint32_t>(Card::TEXTURE_SIZE) ||
+        header.layerCount != static_cast<uint32_t>(LAYER_COUNT) ||
+        header.headerSize != sizeof(CacheHeader)) {
+        std::cout << "Card texture cache " << path << " is out of date" << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void CardTextureCache::close() {
+    if (mapped == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapped);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(mapped), mappedSize);
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    mapped = nullptr;
+    mappedSize = 0;
+}
+
+bool CardTextureCache::build(const std::string& path, WorkerPool& pool) {
+    // Rasterize all layers in parallel, then write them out in order
+    std::vector<std::vector<unsigned char>> layers(LAYER_COUNT);
+    std::vector<std::future<void>> ready;
+    ready.reserve(LAYER_COUNT);
+    ready.push_back(pool.submit([&layers]() {
+        layers[0] = CardRasterizer::rasterize(0, 0, false);
+    }));
+    for (int suit = 0; suit < 4; suit++) {
+        for (int rank = 1; rank <= 13; rank++) {
+            ready.push_back(pool.submit([&layers, rank, suit]() {
+                layers[layerIndex(rank, suit)] = CardRasterizer::rasterize(rank, suit, true);
+            }));
+        }
+    }
+    for (auto& job : ready) {
+        job.get();
+    }
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = static_cast<uint32_t>(Card::TEXTURE_VERSION);
+    header.textureSize = static_cast<uint32_t>(Card::TEXTURE_SIZE);
+    header.layerCount = static_cast<uint32_t>(LAYER_COUNT);
+    header.headerSize = sizeof(CacheHeader);
+
+    // Write under a temporary name so a crash never leaves a half-written cache behind
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to create card texture cache: " << tempPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& layer : layers) {
+            file.write(reinterpret_cast<const char*>(layer.data()), static_cast<std::streamsize>(layer.size()));
+        }
+        if (!file) {
+            std::cerr << "Failed to write card texture cache: " << tempPath << std::endl;
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    std::remove(path.c_str()); // rename() does not replace existing files on Windows
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to move card texture cache into place: " << path << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+const unsigned char* CardTextureCache::getBack() const {
+    if (mapped == nullptr) {
+        return nullptr;
+    }
+    return mapped + sizeof(CacheHeader);
+}
+
+const unsigned char* CardTextureCache::getFront(int rank, int suit) const {
+    if (mapped == nullptr || rank < 1 || rank > 13 || suit < 0 || suit > 3) {
+        return nullptr;
+    }
+    return mapped + sizeof(CacheHeader) + LAYER_BYTES * layerIndex(rank, suit);
+}
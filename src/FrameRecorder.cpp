@@ -0,0 +1,265 @@
+#include "FrameRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+FrameRecorder::FrameRecorder()
+    : nextSlot(0), width(0), height(0), fps(60), stopping(false), haveFrame(false), firstSeconds(0.0),
+      videoFrames(0), skipped(0), captured(0), dropped(0), stalls(0) {
+}
+
+FrameRecorder::~FrameRecorder() {
+    finish();
+}
+
+bool FrameRecorder::start(const std::string& outputPath, int frameWidth, int frameHeight, int framesPerSecond) {
+    finish();
+    if (frameWidth <= 0 || frameHeight <= 0) {
+        return false;
+    }
+    file.open(outputPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open recording: " << outputPath << std::endl;
+        return false;
+    }
+    path = outputPath;
+    width = frameWidth;
+    height = frameHeight;
+    fps = framesPerSecond > 0 ? framesPerSecond : 60;
+    file << "YUV4MPEG2 W" << width << " H" << height << " F" << fps << ":1 Ip A1:1 C420jpeg\n";
+
+    // Stream-read buffers: the driver places them where mapping for the CPU is cheap
+    size_t bytes = static_cast<size_t>(width) * height * 4;
+    for (Slot& slot : slots) {
+        glGenBuffers(1, &slot.buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    nextSlot = 0;
+
+    stopping = false;
+    haveFrame = false;
+    videoFrames = 0;
+    skipped = 0;
+    captured = 0;
+    dropped = 0;
+    stalls = 0;
+    spareBuffers.clear();
+    writer = std::thread(&FrameRecorder::writerLoop, this);
+    std::cout << "Recording " << width << "x" << height << " at " << fps << " fps to " << path
+              << " (" << RING_SIZE << " pixel buffers, writer thread)" << std::endl;
+    return true;
+}
+
+void FrameRecorder::capture(GLuint framebuffer, double seconds) {
+    if (!isRecording()) {
+        return;
+    }
+
+    // Hand finished readbacks to the writer in order, without waiting for any
+    for (int i = 0; i < RING_SIZE; i++) {
+        Slot& slot = slots[(nextSlot + i) % RING_SIZE];
+        if (slot.fence != nullptr && !collect(slot, false)) {
+            break;
+        }
+    }
+
+    // Every buffer still in flight: the GPU is RING_SIZE frames behind, wait for the oldest
+    Slot& slot = slots[nextSlot];
+    if (slot.fence != nullptr) {
+        stalls++;
+        collect(slot, true);
+    }
+
+    // The copy runs on the GPU after the frame; glReadPixels returns right away
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    if (framebuffer == 0) {
+        glReadBuffer(GL_BACK);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.seconds = seconds;
+    nextSlot = (nextSlot + 1) % RING_SIZE;
+    captured++;
+}
+
+bool FrameRecorder::collect(Slot& slot, bool wait) {
+    GLenum state = glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000 : 0); // 1 s
+    if (state == GL_TIMEOUT_EXPIRED && !wait) {
+        return false;
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    if (state == GL_WAIT_FAILED || state == GL_TIMEOUT_EXPIRED) {
+        dropped++;
+        return true;
+    }
+
+    // Take a spare buffer, unless the writer is too far behind
+    Frame frame;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() >= static_cast<size_t>(MAX_QUEUED)) {
+            dropped++;
+            return true;
+        }
+        if (!spareBuffers.empty()) {
+            frame.rgba.swap(spareBuffers.back());
+            spareBuffers.pop_back();
+        }
+    }
+    size_t bytes = static_cast<size_t>(width) * height * 4;
+    frame.rgba.resize(bytes);
+    frame.seconds = slot.seconds;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT);
+    bool mapped = pixels != nullptr;
+    if (mapped) {
+        std::memcpy(frame.rgba.data(), pixels, bytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (!mapped) {
+        dropped++;
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(frame));
+    }
+    wake.notify_one();
+    return true;
+}
+
+void FrameRecorder::finish() {
+    if (!isRecording()) {
+        return;
+    }
+
+    // Oldest first, so the writer still gets the frames in order
+    for (int i = 0; i < RING_SIZE; i++) {
+        Slot& slot = slots[(nextSlot + i) % RING_SIZE];
+        if (slot.fence != nullptr) {
+            collect(slot, true);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+
+    for (Slot& slot : slots) {
+        glDeleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+    }
+    bool written = file.good();
+    file.close();
+    std::cout << "Recorded " << path << ": " << captured << " frames captured, " << videoFrames
+              << " video frames (" << videoFrames / static_cast<double>(fps) << " s), " << skipped
+              << " skipped above " << fps << " fps, " << dropped << " dropped, " << stalls << " readback stalls"
+              << std::endl;
+    if (!written) {
+        std::cerr << "Failed to write recording: " << path << std::endl;
+    }
+    queue.clear();
+    spareBuffers.clear();
+}
+
+void FrameRecorder::writerLoop() {
+    for (;;) {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return; // Stopping, and everything is written
+            }
+            frame = std::move(queue.front());
+            queue.pop_front();
+        }
+        writeFrame(frame);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            spareBuffers.push_back(std::move(frame.rgba));
+        }
+    }
+}
+
+void FrameRecorder::writeFrame(const Frame& frame) {
+    // Video frames that should exist once this one is shown
+    if (!haveFrame) {
+        firstSeconds = frame.seconds;
+    }
+    long long due = static_cast<long long>(std::floor((frame.seconds - firstSeconds) * fps + 0.5)) + 1;
+    if (haveFrame && due <= videoFrames) {
+        skipped++;
+        return;
+    }
+
+    // The previous frame stays on screen until this one was drawn
+    while (haveFrame && videoFrames < due - 1) {
+        file << "FRAME\n";
+        file.write(reinterpret_cast<const char*>(planes.data()), static_cast<std::streamsize>(planes.size()));
+        videoFrames++;
+    }
+    convertToI420(frame.rgba.data(), width, height, planes);
+    file << "FRAME\n";
+    file.write(reinterpret_cast<const char*>(planes.data()), static_cast<std::streamsize>(planes.size()));
+    videoFrames++;
+    haveFrame = true;
+}
+
+void FrameRecorder::convertToI420(const unsigned char* rgba, int frameWidth, int frameHeight,
+                                  std::vector<unsigned char>& output) {
+    int chromaWidth = (frameWidth + 1) / 2;
+    int chromaHeight = (frameHeight + 1) / 2;
+    size_t lumaSize = static_cast<size_t>(frameWidth) * frameHeight;
+    size_t chromaSize = static_cast<size_t>(chromaWidth) * chromaHeight;
+    output.resize(lumaSize + 2 * chromaSize);
+    unsigned char* yPlane = output.data();
+    unsigned char* cbPlane = yPlane + lumaSize;
+    unsigned char* crPlane = cbPlane + chromaSize;
+
+    // One pass over each pair of rows: the luma of all four pixels of a 2x2 block, then
+    // its averaged chroma. Output rows count from the top; GL rows start at the bottom,
+    // and odd edges repeat their last row or column.
+    size_t stride = static_cast<size_t>(frameWidth) * 4;
+    for (int cy = 0; cy < chromaHeight; cy++) {
+        int top = 2 * cy;
+        int bottom = std::min(top + 1, frameHeight - 1);
+        const unsigned char* row0 = rgba + static_cast<size_t>(frameHeight - 1 - top) * stride;
+        const unsigned char* row1 = rgba + static_cast<size_t>(frameHeight - 1 - bottom) * stride;
+        unsigned char* luma0 = yPlane + static_cast<size_t>(top) * frameWidth;
+        unsigned char* luma1 = yPlane + static_cast<size_t>(bottom) * frameWidth;
+        unsigned char* cb = cbPlane + static_cast<size_t>(cy) * chromaWidth;
+        unsigned char* cr = crPlane + static_cast<size_t>(cy) * chromaWidth;
+        for (int cx = 0; cx < chromaWidth; cx++) {
+            int left = 2 * cx;
+            int right = std::min(left + 1, frameWidth - 1);
+            const unsigned char* block[4] = {row0 + left * 4, row0 + right * 4, row1 + left * 4, row1 + right * 4};
+            unsigned char* lumaOut[4] = {luma0 + left, luma0 + right, luma1 + left, luma1 + right};
+            int r = 0, g = 0, b = 0;
+            for (int i = 0; i < 4; i++) {
+                const unsigned char* p = block[i];
+                *lumaOut[i] = static_cast<unsigned char>(((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+                r += p[0];
+                g += p[1];
+                b += p[2];
+            }
+            r = (r + 2) / 4;
+            g = (g + 2) / 4;
+            b = (b + 2) / 4;
+            cb[cx] = static_cast<unsigned char>((-38 * r - 74 * g + 112 * b + 128 + (128 << 8)) >> 8);
+            cr[cx] = static_cast<unsigned char>((112 * r - 94 * g - 18 * b + 128 + (128 << 8)) >> 8);
+        }
+    }
+}
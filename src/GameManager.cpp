@@ -1,12 +1,14 @@
 #include "GameManager.h"
 #include <iostream>
+#include <algorithm>
 
 const float MATCH_CHECK_DELAY = 1.0f; // seconds to show cards before checking match
 
 GameManager::GameManager() 
     : currentState(GameState::IDLE), firstCard(nullptr), secondCard(nullptr),
       score(0), moves(0), totalMatches(0), currentStreak(0), totalStreakBonus(0),
-      stateTimer(0.0f), matchDelay(MATCH_CHECK_DELAY), gameWon(false), animating(false) {
+      stateTimer(0.0f), matchDelay(MATCH_CHECK_DELAY), gameWon(false), animating(false),
+      deal(0), ticks(0) {
 }
 
 GameManager::~GameManager() {
@@ -30,6 +32,26 @@ void GameManager::initialize(int numPairs) {
     deck.createPairs(numPairs);
     deck.shuffle();
     
+    // Atlas layers follow from the faces alone, so they are known before any renderer
+    // has built the atlas. Face requests are only recorded here; the renderer starts
+    // them, and finishes every face on screen before drawing it.
+    deal++;
+    requestedFaces.clear();
+    std::vector<std::pair<int, int>> faces;
+    for (auto& card : deck.getCards()) {
+        faces.push_back({card->getRank(), card->getSuit()});
+    }
+    std::vector<int> layers = Renderer::assignCardLayers(faces);
+    for (size_t i = 0; i < layers.size(); i++) {
+        Card* card = deck.getCards()[i].get();
+        card->setFaceLayer(layers[i]);
+        card->setFaceRequest([this](int layer) {
+            if (std::find(requestedFaces.begin(), requestedFaces.end(), layer) == requestedFaces.end()) {
+                requestedFaces.push_back(layer);
+            }
+        });
+    }
+    
     // Layout cards in a grid
     int cols = 4;
     int rows = (numPairs * 2 + cols - 1) / cols; // Ceiling division
@@ -40,6 +62,8 @@ void GameManager::initialize(int numPairs) {
 }
 
 void GameManager::update(float deltaTime) {
+    ticks++;
+    
     // Update all cards
     for (auto& card : deck.getCards()) {
         card->update(deltaTime);
@@ -145,71 +169,84 @@ void GameManager::handleCardClick(Card* clickedCard) {
     }
 }
 
-void GameManager::render(GLuint shaderProgram, glm::mat4 viewMatrix, glm::mat4 projMatrix, Renderer* renderer) {
-    // Render all cards
+void GameManager::publish(FrameSnapshot& snapshot) const {
+    snapshot.tick = ticks;
+    snapshot.deal = deal;
+    snapshot.faces.clear();
+    snapshot.resting.clear();
+    snapshot.animated.clear();
     for (auto& card : deck.getCards()) {
-        card->draw(shaderProgram, viewMatrix, projMatrix);
+        snapshot.faces.push_back({card->getRank(), card->getSuit()});
+        (card->getIsFlipping() ? snapshot.animated : snapshot.resting).push_back(card->getInstance());
+    }
+    snapshot.hud.clear();
+    buildHud(snapshot.hud);
+    snapshot.requestedFaces = requestedFaces;
+    snapshot.continuousFrames = needsContinuousFrames();
+}
+
+void GameManager::render(Renderer* renderer) {
+    publish(frame);
+    view.render(frame, renderer);
+}
+
+void GameManager::buildHud(std::vector<HudLine>& lines) const {
+    // Calculate elapsed time
+    auto currentTime = std::chrono::high_resolution_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(currentTime - gameStartTime);
+    int elapsedSeconds = elapsed.count();
+    int minutes = elapsedSeconds / 60;
+    int seconds = elapsedSeconds % 60;
+    
+    // Enhanced HUD with better readability and score breakdown
+    std::string timeText = "Time: " + std::to_string(minutes) + ":" + 
+                          (seconds < 10 ? "0" : "") + std::to_string(seconds);
+    lines.push_back({timeText, -0.95f, 0.9f, 1.2f});
+    
+    std::string movesText = "Moves: " + std::to_string(moves);
+    lines.push_back({movesText, -0.95f, 0.8f, 1.2f});
+    
+    std::string scoreText = "Score: " + std::to_string(score);
+    lines.push_back({scoreText, -0.95f, 0.7f, 1.2f});
+    
+    // Display current streak if active
+    if (currentStreak > 0) {
+        std::string streakText = "Streak: " + std::to_string(currentStreak);
+        lines.push_back({streakText, -0.95f, 0.6f, 1.0f});
     }
     
-    // Render UI elements on screen
-    if (renderer) {
-        // Calculate elapsed time
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(currentTime - gameStartTime);
-        int elapsedSeconds = elapsed.count();
-        int minutes = elapsedSeconds / 60;
-        int seconds = elapsedSeconds % 60;
+    // Display match count
+    std::string matchText = "Matches: " + std::to_string(totalMatches);
+    lines.push_back({matchText, -0.95f, 0.5f, 1.0f});
+    
+    // Display win message with score breakdown
+    if (gameWon) {
+        ScoreBreakdown breakdown = calculateFinalScore();
         
-        // Enhanced HUD with better readability and score breakdown
-        std::string timeText = "Time: " + std::to_string(minutes) + ":" + 
-                              (seconds < 10 ? "0" : "") + std::to_string(seconds);
-        renderer->renderEnhancedText(timeText, -0.95f, 0.9f, 1.2f);
+        lines.push_back({"YOU WON!", -0.3f, 0.2f, 2.5f});
         
-        std::string movesText = "Moves: " + std::to_string(moves);
-        renderer->renderEnhancedText(movesText, -0.95f, 0.8f, 1.2f);
+        // Score breakdown
+        std::string finalScoreText = "Final Score: " + std::to_string(breakdown.finalScore);
+        lines.push_back({finalScoreText, -0.4f, 0.0f, 1.5f});
         
-        std::string scoreText = "Score: " + std::to_string(score);
-        renderer->renderEnhancedText(scoreText, -0.95f, 0.7f, 1.2f);
+        std::string baseText = "Base: " + std::to_string(breakdown.base);
+        lines.push_back({baseText, -0.4f, -0.1f, 1.0f});
         
-        // Display current streak if active
-        if (currentStreak > 0) {
-            std::string streakText = "Streak: " + std::to_string(currentStreak);
-            renderer->renderEnhancedText(streakText, -0.95f, 0.6f, 1.0f);
-        }
+        std::string bonusText = "Bonuses: +" + std::to_string(breakdown.bonuses);
+        lines.push_back({bonusText, -0.4f, -0.2f, 1.0f});
         
-        // Display match count
-        std::string matchText = "Matches: " + std::to_string(totalMatches);
-        renderer->renderEnhancedText(matchText, -0.95f, 0.5f, 1.0f);
+        std::string penaltyText = "Penalties: -" + std::to_string(breakdown.penalties);
+        lines.push_back({penaltyText, -0.4f, -0.3f, 1.0f});
         
-        // Display win message with score breakdown
-        if (gameWon) {
-            ScoreBreakdown breakdown = calculateFinalScore();
-            
-            renderer->renderEnhancedText("YOU WON!", -0.3f, 0.2f, 2.5f);
-            
-            // Score breakdown
-            std::string finalScoreText = "Final Score: " + std::to_string(breakdown.finalScore);
-            renderer->renderEnhancedText(finalScoreText, -0.4f, 0.0f, 1.5f);
-            
-            std::string baseText = "Base: " + std::to_string(breakdown.base);
-            renderer->renderEnhancedText(baseText, -0.4f, -0.1f, 1.0f);
-            
-            std::string bonusText = "Bonuses: +" + std::to_string(breakdown.bonuses);
-            renderer->renderEnhancedText(bonusText, -0.4f, -0.2f, 1.0f);
-            
-            std::string penaltyText = "Penalties: -" + std::to_string(breakdown.penalties);
-            renderer->renderEnhancedText(penaltyText, -0.4f, -0.3f, 1.0f);
-            
-            // Display stars
-            std::string starsText = "Stars: ";
-            for (int i = 0; i < breakdown.stars; i++) {
-                starsText += "*";
-            }
-            for (int i = breakdown.stars; i < 3; i++) {
-                starsText += "-";
-            }
-            renderer->renderEnhancedText(starsText, -0.4f, -0.4f, 1.2f);
+        // Display stars
+        std::string starsText = "Stars: ";
+        for (int i = 0; i < breakdown.stars; i++) {
+            starsText += "*";
+        }
+        for (int i = breakdown.stars; i < 3; i++) {
+            starsText += "-";
         }
+        lines.push_back({starsText, -0.4f, -0.4f, 1.2f});
     }
 }
 
@@ -270,10 +307,23 @@ void GameManager::checkWinCondition() {
     }
 }
 
-void GameManager::handleMouseClick(float x, float y) {
+bool GameManager::handleMouseClick(float x, float y) {
     Card* clickedCard = deck.getCardAt(x, y);
-    if (clickedCard) {
-        handleCardClick(clickedCard);
+    if (!clickedCard) {
+        return false;
+    }
+    bool wasFlipping = clickedCard->getIsFlipping();
+    handleCardClick(clickedCard);
+    return !wasFlipping && clickedCard->getIsFlipping();
+}
+
+void GameManager::handleMouseMove(float x, float y) {
+    // Cards near the pointer are the likely next flips: start generating their faces
+    for (auto& card : deck.getCards()) {
+        if (card->getState() == CardState::FACE_DOWN &&
+            glm::distance(card->getPosition(), glm::vec2(x, y)) < FACE_PREFETCH_RADIUS) {
+            card->prepareFace();
+        }
     }
 }
 
@@ -283,6 +333,27 @@ float GameManager::getElapsedTime() const {
     return duration.count() / 1000.0f; // Convert to seconds
 }
 
+bool GameManager::needsContinuousFrames() const {
+    // State timers advance by frame deltas, so they need frames as much as flips do
+    if (currentState == GameState::FLIPPING_FIRST || currentState == GameState::FLIPPING_SECOND ||
+        currentState == GameState::CHECK_MATCH || currentState == GameState::RESOLVE) {
+        return true;
+    }
+    for (const auto& card : deck.getCards()) {
+        if (card->getIsFlipping()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float GameManager::getSecondsUntilClockTick() const {
+    // The HUD shows whole seconds since gameStartTime
+    auto now = std::chrono::high_resolution_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - gameStartTime);
+    return (1000 - elapsed.count() % 1000) / 1000.0f;
+}
+
 void GameManager::reset(int numPairs) {
     initialize(numPairs);
 }
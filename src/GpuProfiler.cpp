@@ -0,0 +1,118 @@
+#include "GpuProfiler.h"
+#include <algorithm>
+
+void GpuProfiler::RollingStats::add(float milliseconds) {
+    samples[next] = milliseconds;
+    next = (next + 1) % HISTORY;
+    count = std::min(count + 1, HISTORY);
+    last = milliseconds;
+}
+
+float GpuProfiler::RollingStats::getAverage() const {
+    if (count == 0) {
+        return 0.0f;
+    }
+    float total = 0.0f;
+    for (int i = 0; i < count; i++) {
+        total += samples[i];
+    }
+    return total / count;
+}
+
+float GpuProfiler::RollingStats::getMax() const {
+    float result = 0.0f;
+    for (int i = 0; i < count; i++) {
+        result = std::max(result, samples[i]);
+    }
+    return result;
+}
+
+GpuProfiler::GpuProfiler() : currentFrame(0), activePass(-1), droppedResults(0) {
+}
+
+GpuProfiler::~GpuProfiler() {
+    release();
+}
+
+bool GpuProfiler::initialize(const std::vector<std::string>& passNames) {
+    release();
+    if (passNames.empty() || passNames.size() > static_cast<size_t>(MAX_PASSES)) {
+        return false;
+    }
+    names = passNames;
+    for (FrameQueries& frame : frames) {
+        glGenQueries(static_cast<GLsizei>(names.size()), frame.queries);
+    }
+    clearStats();
+    return true;
+}
+
+void GpuProfiler::release() {
+    if (activePass >= 0) {
+        glEndQuery(GL_TIME_ELAPSED);
+        activePass = -1;
+    }
+    if (!names.empty()) {
+        for (FrameQueries& frame : frames) {
+            glDeleteQueries(static_cast<GLsizei>(names.size()), frame.queries);
+            frame = FrameQueries();
+        }
+    }
+    names.clear();
+}
+
+void GpuProfiler::beginFrame() {
+    if (names.empty()) {
+        return;
+    }
+    if (activePass >= 0) {
+        endPass();
+    }
+    
+    // The oldest frame's queries: harvest whatever finished, then they are free again
+    currentFrame = (currentFrame + 1) % FRAMES_IN_FLIGHT;
+    FrameQueries& frame = frames[currentFrame];
+    for (int pass = 0; pass < getPassCount(); pass++) {
+        if (!frame.issued[pass]) {
+            continue;
+        }
+        frame.issued[pass] = false;
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[pass], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            droppedResults++; // Never wait; the query is simply reissued
+            continue;
+        }
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(frame.queries[pass], GL_QUERY_RESULT, &nanoseconds);
+        stats[pass].add(static_cast<float>(nanoseconds / 1.0e6));
+    }
+}
+
+void GpuProfiler::beginPass(int pass) {
+    if (pass < 0 || pass >= getPassCount() || activePass >= 0) {
+        return;
+    }
+    FrameQueries& frame = frames[currentFrame];
+    if (frame.issued[pass]) {
+        return;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[pass]);
+    frame.issued[pass] = true;
+    activePass = pass;
+}
+
+void GpuProfiler::endPass() {
+    if (activePass < 0) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    activePass = -1;
+}
+
+void GpuProfiler::clearStats() {
+    for (RollingStats& passStats : stats) {
+        passStats.clear();
+    }
+    droppedResults = 0;
+}
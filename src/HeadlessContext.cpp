@@ -0,0 +1,207 @@
+#include "HeadlessContext.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#ifdef HAVE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+HeadlessContext::HeadlessContext()
+    : display(nullptr), context(nullptr), sharedContext(nullptr), framebuffer(0), colorBuffer(0), depthBuffer(0), width(0), height(0) {
+}
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+bool HeadlessContext::create(int targetWidth, int targetHeight) {
+#ifdef HAVE_EGL
+    // Prefer Mesa's surfaceless platform: no window system at all
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay != nullptr) {
+        eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    EGLint major = 0, minor = 0;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        std::cerr << "Failed to initialize EGL" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+    
+    // Same context as the windowed game; no config or surface is needed since
+    // everything renders into our own framebuffer object
+    const char* extensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+    std::string extensionList = extensions != nullptr ? extensions : "";
+    if (extensionList.find("EGL_KHR_surfaceless_context") == std::string::npos ||
+        extensionList.find("EGL_KHR_no_config_context") == std::string::npos) {
+        std::cerr << "EGL " << major << "." << minor << " lacks surfaceless contexts" << std::endl;
+        destroy();
+        return false;
+    }
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT || !eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        std::cerr << "Failed to create an OpenGL 3.3 core context with EGL" << std::endl;
+        if (eglContext != EGL_NO_CONTEXT) {
+            eglDestroyContext(eglDisplay, eglContext);
+        }
+        destroy();
+        return false;
+    }
+    context = eglContext;
+    
+    // GL entry points are needed before the framebuffer can be made
+    glewExperimental = GL_TRUE;
+    GLenum glewStatus = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    if (glewStatus == GLEW_ERROR_NO_GLX_DISPLAY) {
+        glewStatus = GLEW_OK; // GLX-built GLEW still resolves core functions
+    }
+#endif
+    if (glewStatus != GLEW_OK) {
+        std::cerr << "Failed to initialize GLEW" << std::endl;
+        destroy();
+        return false;
+    }
+    
+    width = targetWidth;
+    height = targetHeight;
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Headless framebuffer incomplete" << std::endl;
+        destroy();
+        return false;
+    }
+    glViewport(0, 0, width, height);
+    
+    std::cout << "Headless context: " << glGetString(GL_RENDERER) << ", " << width << "x" << height << std::endl;
+    return true;
+#else
+    (void)targetWidth;
+    (void)targetHeight;
+    std::cerr << "Headless mode needs EGL; rebuild with HEADLESS=1" << std::endl;
+    return false;
+#endif
+}
+
+bool HeadlessContext::createSharedContext() {
+#ifdef HAVE_EGL
+    if (context == nullptr) {
+        return false;
+    }
+    if (sharedContext != nullptr) {
+        return true;
+    }
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(display, EGL_NO_CONFIG_KHR, static_cast<EGLContext>(context), contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT) {
+        std::cerr << "Failed to create a shared EGL context" << std::endl;
+        return false;
+    }
+    sharedContext = eglContext;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool HeadlessContext::makeSharedContextCurrent() {
+#ifdef HAVE_EGL
+    // The bound API is per thread
+    return sharedContext != nullptr && eglBindAPI(EGL_OPENGL_API) &&
+           eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, static_cast<EGLContext>(sharedContext));
+#else
+    return false;
+#endif
+}
+
+void HeadlessContext::releaseSharedContext() {
+#ifdef HAVE_EGL
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+#endif
+}
+
+void HeadlessContext::destroy() {
+#ifdef HAVE_EGL
+    if (sharedContext != nullptr) {
+        eglDestroyContext(display, sharedContext);
+    }
+    if (context != nullptr) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (framebuffer != 0) {
+            glDeleteFramebuffers(1, &framebuffer);
+        }
+        if (colorBuffer != 0) {
+            glDeleteRenderbuffers(1, &colorBuffer);
+        }
+        if (depthBuffer != 0) {
+            glDeleteRenderbuffers(1, &depthBuffer);
+        }
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+    }
+    if (display != nullptr) {
+        eglTerminate(display);
+    }
+#endif
+    display = nullptr;
+    context = nullptr;
+    sharedContext = nullptr;
+    framebuffer = 0;
+    colorBuffer = 0;
+    depthBuffer = 0;
+}
+
+bool HeadlessContext::saveFrame(const std::string& path) const {
+    if (framebuffer == 0) {
+        return false;
+    }
+    
+    // Tightly packed RGB rows, bottom row first as GL returns them
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write frame: " << path << std::endl;
+        return false;
+    }
+    file << "P6\n" << width << " " << height << "\n255\n";
+    size_t rowBytes = static_cast<size_t>(width) * 3;
+    for (int row = height - 1; row >= 0; row--) {
+        file.write(reinterpret_cast<const char*>(&pixels[row * rowBytes]), rowBytes);
+    }
+    return file.good();
+}
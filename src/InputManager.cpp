@@ -1,7 +1,7 @@
 #include "InputManager.h"
 
 InputManager::InputManager(GLFWwindow* win) 
-    : window(win), mousePressed(false), mouseReleased(false),
+    : window(win), mousePressed(false), mouseJustPressed(false), mouseReleased(false),
       mousePosition(0.0f, 0.0f), lastMousePosition(0.0f, 0.0f) {
     
     // Set this instance as user pointer for callbacks
@@ -18,6 +18,7 @@ InputManager::~InputManager() {
 
 void InputManager::update() {
     // Reset per-frame states
+    mouseJustPressed = false;
     mouseReleased = false;
     
     // Update last mouse position
@@ -31,13 +32,15 @@ void InputManager::processInput(float deltaTime) {
     }
 }
 
-glm::vec2 InputManager::screenToWorld(glm::vec2 screenPos, int windowWidth, int windowHeight) {
-    // Convert screen coordinates to OpenGL coordinates
-    // Screen: (0,0) top-left, (width,height) bottom-right
-    // OpenGL: (-width/2, -height/2) bottom-left, (width/2, height/2) top-right
+glm::vec2 InputManager::screenToWorld(glm::vec2 screenPos, const glm::mat4& projection, int windowWidth, int windowHeight) {
+    // Screen: (0,0) top-left, (width,height) bottom-right; normalized device
+    // coordinates: (-1,-1) bottom-left, (1,1) top-right, whatever the window size
+    float ndcX = screenPos.x / windowWidth * 2.0f - 1.0f;
+    float ndcY = 1.0f - screenPos.y / windowHeight * 2.0f;
     
-    float worldX = (screenPos.x - windowWidth / 2.0f);
-    float worldY = (windowHeight / 2.0f - screenPos.y);
+    // An orthographic projection only scales and offsets each axis: undo that
+    float worldX = (ndcX - projection[3][0]) / projection[0][0];
+    float worldY = (ndcY - projection[3][1]) / projection[1][1];
     
     return glm::vec2(worldX, worldY);
 }
@@ -56,11 +59,15 @@ void InputManager::mouseButtonCallback(GLFWwindow* window, int button, int actio
     if (!inputManager) return;
     
     if (button == GLFW_MOUSE_BUTTON_LEFT) {
+        // Timestamps are taken as the event is dispatched, the earliest the app can see it
         if (action == GLFW_PRESS) {
             inputManager->mousePressed = true;
+            inputManager->mouseJustPressed = true;
+            inputManager->pressTime = std::chrono::steady_clock::now();
         } else if (action == GLFW_RELEASE) {
             inputManager->mousePressed = false;
             inputManager->mouseReleased = true;
+            inputManager->releaseTime = std::chrono::steady_clock::now();
         }
     }
 }
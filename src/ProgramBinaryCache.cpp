@@ -0,0 +1,136 @@
+#include "ProgramBinaryCache.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+    uint64_t driverKey;
+};
+
+struct EntryHeader {
+    uint64_t sourceKey;
+    uint32_t format;
+    uint32_t length;
+};
+
+const char CACHE_MAGIC[8] = {'P', 'R', 'O', 'G', 'B', 'I', 'N', '\0'};
+const uint32_t MAX_BINARY_BYTES = 64u << 20; // Anything larger is a damaged file
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache() : driverKey(0), dirty(false) {
+}
+
+uint64_t ProgramBinaryCache::hash(const std::string& text, uint64_t seed) {
+    uint64_t value = seed;
+    for (unsigned char c : text) {
+        value ^= c;
+        value *= 1099511628211ull;
+    }
+    return value;
+}
+
+bool ProgramBinaryCache::load(const std::string& path, uint64_t driver) {
+    binaries.clear();
+    driverKey = driver;
+    dirty = false;
+    
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    CacheHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != VERSION) {
+        std::cout << "Program binary cache " << path << " is out of date" << std::endl;
+        return false;
+    }
+    if (header.driverKey != driver) {
+        std::cout << "Program binary cache " << path << " was written by another driver" << std::endl;
+        return false;
+    }
+    
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        EntryHeader entry;
+        if (!file.read(reinterpret_cast<char*>(&entry), sizeof(entry)) || entry.length > MAX_BINARY_BYTES) {
+            break;
+        }
+        Binary binary;
+        binary.format = entry.format;
+        binary.data.resize(entry.length);
+        if (!file.read(reinterpret_cast<char*>(binary.data.data()), entry.length)) {
+            break;
+        }
+        binaries[entry.sourceKey] = std::move(binary);
+    }
+    if (binaries.size() != header.entryCount) {
+        std::cout << "Program binary cache " << path << " is truncated" << std::endl;
+        binaries.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ProgramBinaryCache::save(const std::string& path) {
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = VERSION;
+    header.entryCount = static_cast<uint32_t>(binaries.size());
+    header.driverKey = driverKey;
+    
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to create program binary cache: " << tempPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& entry : binaries) {
+            EntryHeader entryHeader;
+            entryHeader.sourceKey = entry.first;
+            entryHeader.format = entry.second.format;
+            entryHeader.length = static_cast<uint32_t>(entry.second.data.size());
+            file.write(reinterpret_cast<const char*>(&entryHeader), sizeof(entryHeader));
+            file.write(reinterpret_cast<const char*>(entry.second.data.data()),
+                       static_cast<std::streamsize>(entry.second.data.size()));
+        }
+        if (!file) {
+            std::cerr << "Failed to write program binary cache: " << tempPath << std::endl;
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    
+    std::remove(path.c_str()); // rename() does not replace existing files on Windows
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to move program binary cache into place: " << path << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+const ProgramBinaryCache::Binary* ProgramBinaryCache::find(uint64_t sourceKey) const {
+    auto it = binaries.find(sourceKey);
+    return it == binaries.end() ? nullptr : &it->second;
+}
+
+void ProgramBinaryCache::store(uint64_t sourceKey, Binary binary) {
+    binaries[sourceKey] = std::move(binary);
+    dirty = true;
+}
+
+void ProgramBinaryCache::remove(uint64_t sourceKey) {
+    if (binaries.erase(sourceKey) > 0) {
+        dirty = true;
+    }
+}
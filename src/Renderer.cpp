@@ -1,11 +1,28 @@
 #include "Renderer.h"
+#include "Card.h"
+#include "CardRasterizer.h"
+#include "BitmapFont.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <vector>
+#include <map>
+#include <chrono>
+#include <future>
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+#include <cstdio>
 
-// Global VAO for card rendering (accessible by Card class)
-GLuint g_cardVAO = 0;
+// Finished card textures, next to the executable's working directory like shaders/
+const char* const CARD_CACHE_PATH = "card_textures.cache";
+
+// Linked shader programs from earlier runs, valid for the same driver only
+const char* const PROGRAM_CACHE_PATH = "program_binaries.cache";
+
+// TrueType HUD font, baked into a distance field atlas at startup
+const char* const HUD_FONT_PATH = "assets/fonts/SourceCodePro-Bold.ttf";
 
 // Vertex data for a quad
 const float quadVertices[] = {
@@ -21,7 +38,16 @@ const unsigned int quadIndices[] = {
     2, 3, 0
 };
 
-Renderer::Renderer() : VAO(0), VBO(0), EBO(0), cardShaderProgram(0), textShaderProgram(0) {
+Renderer::Renderer() : VAO(0), VBO(0), EBO(0), cardVAO(0), cameraUBO(0),
+                       cardShaderProgram(0), textShaderProgram(0),
+                       cardAtlas(0), cardPalette(0), cardAtlasLayers(0), cardAtlasIndexed(false),
+                       proceduralFaces(false), indexedFaces(true), loadingOverlay(false), loadingAssets(false),
+                       sdfFontAtlas(0), sdfShaderProgram(0),
+                       spriteVAO(0), spriteEBO(0), spriteCapacity(0), spriteBufferGeneration(0),
+                       activeLayer(-1), compositeProgram(0), compositeScaledProgram(0), compositeVAO(0),
+                       backgroundColor(0.2f, 0.3f, 0.3f, 1.0f), targetFramebuffer(0), uploadedView(1.0f), uploadedProjection(1.0f),
+                       cameraUploaded(false), maxFramesInFlight(0), frameNumber(0), completedFrame(0),
+                       slotWaitMilliseconds(0.0f), sceneRedrawn(false), gpuTimingOverlay(false) {
 }
 
 Renderer::~Renderer() {
@@ -29,12 +55,32 @@ Renderer::~Renderer() {
 }
 
 bool Renderer::initialize() {
-    // Initialize GLEW
-    if (glewInit() != GLEW_OK) {
+    // Initialize GLEW; under EGL (headless mode) a GLX-built GLEW reports the missing
+    // X display but still resolves the core entry points
+    GLenum glewStatus = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    if (glewStatus == GLEW_ERROR_NO_GLX_DISPLAY) {
+        glewStatus = GLEW_OK;
+    }
+#endif
+    if (glewStatus != GLEW_OK) {
         std::cerr << "Failed to initialize GLEW" << std::endl;
         return false;
     }
     
+    // Program binaries only load on the driver that produced them, so the cache is keyed by it
+    GLint binaryFormats = 0;
+    if (programCacheEnabled && (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+    }
+    programBinariesSupported = binaryFormats > 0;
+    if (programBinariesSupported) {
+        uint64_t driver = ProgramBinaryCache::hash(reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+        driver = ProgramBinaryCache::hash(reinterpret_cast<const char*>(glGetString(GL_RENDERER)), driver);
+        driver = ProgramBinaryCache::hash(reinterpret_cast<const char*>(glGetString(GL_VERSION)), driver);
+        programCache.load(PROGRAM_CACHE_PATH, driver);
+    }
+    
     // Create and compile shaders
     cardShaderProgram = loadShader("shaders/card_vertex.glsl", "shaders/card_fragment.glsl");
     if (cardShaderProgram == 0) {
@@ -42,6 +88,116 @@ bool Renderer::initialize() {
         return false;
     }
     
+    // HUD text and panels sample ordinary 2D textures
+    textShaderProgram = loadShader("shaders/text_vertex.glsl", "shaders/text_fragment.glsl");
+    if (textShaderProgram == 0) {
+        std::cerr << "Failed to load text shaders" << std::endl;
+        return false;
+    }
+    
+    // Resolve hot uniform locations once; samplers and the card size never change
+    cardUniforms.proceduralFaces = getUniformLocation(cardShaderProgram, "proceduralFaces");
+    cardUniforms.indexedFaces = getUniformLocation(cardShaderProgram, "indexedFaces");
+    glUseProgram(cardShaderProgram);
+    GLint atlasLoc = getUniformLocation(cardShaderProgram, "cardAtlas");
+    GLint paletteLoc = getUniformLocation(cardShaderProgram, "cardPalette");
+    GLint sizeLoc = getUniformLocation(cardShaderProgram, "cardSize");
+    if (atlasLoc >= 0) glUniform1i(atlasLoc, 0); // Array and 2D samplers must never share a unit
+    if (paletteLoc >= 0) glUniform1i(paletteLoc, 1);
+    if (sizeLoc >= 0) glUniform2f(sizeLoc, Card::WIDTH, Card::HEIGHT);
+    glUseProgram(textShaderProgram);
+    GLint textureLoc = getUniformLocation(textShaderProgram, "cardTexture");
+    if (textureLoc >= 0) glUniform1i(textureLoc, 0);
+    glUseProgram(0);
+    
+    // Distance field text: bake the TrueType font once; without it the pixel fonts are used
+    sdfShaderProgram = loadShader("shaders/text_vertex.glsl", "shaders/text_sdf_fragment.glsl");
+    if (sdfShaderProgram != 0 && sdfFont.load(HUD_FONT_PATH)) {
+        glGenTextures(1, &sdfFontAtlas);
+        glBindTexture(GL_TEXTURE_2D, sdfFontAtlas);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, sdfFont.getAtlasWidth(), sdfFont.getAtlasHeight(), 0,
+                     GL_RED, GL_UNSIGNED_BYTE, sdfFont.getAtlas().data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        
+        // Outline and drop shadow widths are in atlas pixels, so they scale with the text
+        glUseProgram(sdfShaderProgram);
+        GLint fontLoc = getUniformLocation(sdfShaderProgram, "fontAtlas");
+        GLint outlineLoc = getUniformLocation(sdfShaderProgram, "outlineWidth");
+        GLint shadowLoc = getUniformLocation(sdfShaderProgram, "shadowOffset");
+        if (fontLoc >= 0) glUniform1i(fontLoc, 0);
+        if (outlineLoc >= 0) glUniform1f(outlineLoc, 1.5f * SdfFont::PIXEL_DIST_SCALE / 255.0f);
+        if (shadowLoc >= 0) {
+            glUniform2f(shadowLoc, 1.5f / sdfFont.getAtlasWidth(), 1.5f / sdfFont.getAtlasHeight());
+        }
+        glUseProgram(0);
+        std::cout << "HUD font atlas: " << sdfFont.getAtlasWidth() << "x" << sdfFont.getAtlasHeight()
+                  << " distance field from " << HUD_FONT_PATH << std::endl;
+    } else {
+        std::cerr << "TrueType HUD font unavailable, using pixel fonts" << std::endl;
+    }
+    
+    // Layer compositors, texel for texel and upscaling the board layers (dynamic
+    // resolution); the layers themselves are allocated on first use
+    compositeProgram = loadShader("shaders/composite_vertex.glsl", "shaders/composite_fragment.glsl");
+    compositeScaledProgram = loadShader("shaders/composite_vertex.glsl", "shaders/composite_scaled_fragment.glsl");
+    if (compositeProgram == 0 || compositeScaledProgram == 0) {
+        std::cerr << "Failed to load composite shaders" << std::endl;
+        return false;
+    }
+    const char* layerSamplers[LAYER_COUNT] = {"boardLayer", "animationLayer", "hudLayer"};
+    for (GLuint program : {compositeProgram, compositeScaledProgram}) {
+        glUseProgram(program);
+        for (int i = 0; i < LAYER_COUNT; i++) {
+            GLint layerLoc = getUniformLocation(program, layerSamplers[i]);
+            if (layerLoc >= 0) glUniform1i(layerLoc, i);
+        }
+    }
+    glUseProgram(0);
+    glGenVertexArrays(1, &compositeVAO);
+    
+    // Every program is loaded now; keep newly linked ones for the next start
+    std::cout << "Shader programs ready in " << shaderMilliseconds << " ms (" << programsFromCache
+              << " from binary cache, " << programsCompiled << " compiled"
+              << (programBinariesSupported ? "" : ", binary cache " + std::string(programCacheEnabled ? "unsupported" : "disabled"))
+              << ")" << std::endl;
+    if (programCache.isDirty()) {
+        programCache.save(PROGRAM_CACHE_PATH);
+    }
+    
+    // Camera block: view and projection (updated in beginFrame), then the fixed UI overlay projection
+    glm::mat4 cameraData[3] = {glm::mat4(1.0f), glm::mat4(1.0f),
+                               glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f)};
+    glGenBuffers(1, &cameraUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(cameraData), &cameraData[0][0][0], GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, cameraUBO);
+    
+    // Rasterize both HUD fonts once; text rendering never creates textures after this
+    if (!buildFontAtlas(basicFont, BitmapFont::BASIC.coverage, BitmapFont::BASIC_SIZE, GL_NEAREST) ||
+        !buildFontAtlas(hudFont, BitmapFont::HUD.coverage, BitmapFont::HUD_SIZE, GL_LINEAR)) {
+        std::cerr << "Failed to create font atlases" << std::endl;
+        return false;
+    }
+    
+    // Map the card texture cache, generating it first if it is missing or stale
+    if (!cardCache.open(CARD_CACHE_PATH)) {
+        auto cacheStart = std::chrono::high_resolution_clock::now();
+        if (CardTextureCache::build(CARD_CACHE_PATH, texturePool) && cardCache.open(CARD_CACHE_PATH)) {
+            auto cacheTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - cacheStart);
+            std::cout << "Card texture cache written in " << cacheTime.count() / 1000.0f << " ms" << std::endl;
+        } else {
+            std::cerr << "Card texture cache unavailable, generating faces on demand" << std::endl;
+        }
+    }
+    
     // Set up vertex data and buffers
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -66,21 +222,64 @@ bool Renderer::initialize() {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
     
-    // Set global VAO for card rendering
-    g_cardVAO = VAO;
+    // Every per-frame vertex stream shares one ring buffer
+    if (!streamBuffer.create(STREAM_SEGMENT_BYTES)) {
+        std::cerr << "Failed to create the stream buffer" << std::endl;
+        return false;
+    }
+    std::cout << "Dynamic vertex data: " << StreamBuffer::SEGMENTS << " x " << STREAM_SEGMENT_BYTES / 1024 << " KB "
+              << (streamBuffer.isPersistent() ? "persistently mapped ring" : "orphaned stream buffer") << std::endl;
+    
+    // Card VAO: the same quad plus one CardInstance per card, advanced per instance;
+    // drawCards points the instance attributes at each board's place in the ring
+    glGenVertexArrays(1, &cardVAO);
+    glBindVertexArray(cardVAO);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    
+    for (GLuint attribute = 2; attribute <= 4; attribute++) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    
+    // Sprite VAO: SpriteVertex quads from the ring, indexed by a buffer sized on first flush
+    glGenVertexArrays(1, &spriteVAO);
+    glGenBuffers(1, &spriteEBO);
+    glBindVertexArray(spriteVAO);
     
-    // Enable blending for transparency
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, spriteEBO);
+    for (GLuint attribute = 0; attribute <= 3; attribute++) {
+        glEnableVertexAttribArray(attribute);
+    }
+    pointSpriteVertices();
+    glBindVertexArray(0);
+    
+    // Enable blending for transparency. Alpha accumulates as coverage, so layers
+    // cleared to transparent end up holding premultiplied colors for the compositor.
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
     
     return true;
 }
 
 void Renderer::cleanup() {
+    // Every pending upload completes before anything it writes to is deleted
+    assetLoader.stop();
     if (VAO != 0) {
         glDeleteVertexArrays(1, &VAO);
         VAO = 0;
-        g_cardVAO = 0; // Reset global VAO
+    }
+    if (cardVAO != 0) {
+        glDeleteVertexArrays(1, &cardVAO);
+        cardVAO = 0;
     }
     if (VBO != 0) {
         glDeleteBuffers(1, &VBO);
@@ -90,6 +289,37 @@ void Renderer::cleanup() {
         glDeleteBuffers(1, &EBO);
         EBO = 0;
     }
+    if (spriteVAO != 0) {
+        glDeleteVertexArrays(1, &spriteVAO);
+        spriteVAO = 0;
+    }
+    if (spriteEBO != 0) {
+        glDeleteBuffers(1, &spriteEBO);
+        spriteEBO = 0;
+        spriteCapacity = 0;
+    }
+    spriteVertices.clear();
+    spriteRuns.clear();
+    streamBuffer.release();
+    releaseLayers();
+    gpuProfiler.release();
+    if (compositeVAO != 0) {
+        glDeleteVertexArrays(1, &compositeVAO);
+        compositeVAO = 0;
+    }
+    if (compositeProgram != 0) {
+        glDeleteProgram(compositeProgram);
+        compositeProgram = 0;
+    }
+    if (compositeScaledProgram != 0) {
+        glDeleteProgram(compositeScaledProgram);
+        compositeScaledProgram = 0;
+    }
+    cameraUploaded = false;
+    if (cameraUBO != 0) {
+        glDeleteBuffers(1, &cameraUBO);
+        cameraUBO = 0;
+    }
     if (cardShaderProgram != 0) {
         glDeleteProgram(cardShaderProgram);
         cardShaderProgram = 0;
@@ -98,9 +328,24 @@ void Renderer::cleanup() {
         glDeleteProgram(textShaderProgram);
         textShaderProgram = 0;
     }
+    releaseFrameFences();
+    releaseCardAtlas();
+    releaseFontAtlas(basicFont);
+    releaseFontAtlas(hudFont);
+    if (sdfFontAtlas != 0) {
+        glDeleteTextures(1, &sdfFontAtlas);
+        sdfFontAtlas = 0;
+    }
+    if (sdfShaderProgram != 0) {
+        glDeleteProgram(sdfShaderProgram);
+        sdfShaderProgram = 0;
+    }
+    cardCache.close();
 }
 
 GLuint Renderer::loadShader(const std::string& vertexPath, const std::string& fragmentPath) {
+    auto loadStart = std::chrono::high_resolution_clock::now();
+    
     // Read vertex shader source
     std::ifstream vertexFile(vertexPath);
     if (!vertexFile.is_open()) {
@@ -125,6 +370,19 @@ GLuint Renderer::loadShader(const std::string& vertexPath, const std::string& fr
     std::string fragmentSource = fragmentStream.str();
     fragmentFile.close();
     
+    // A binary linked from exactly these sources skips compiling and linking
+    uint64_t sourceKey = ProgramBinaryCache::hash(vertexSource);
+    sourceKey = ProgramBinaryCache::hash(std::string(1, '\0'), sourceKey); // Keep the two sources apart
+    sourceKey = ProgramBinaryCache::hash(fragmentSource, sourceKey);
+    GLuint shaderProgram = loadProgramBinary(sourceKey);
+    if (shaderProgram != 0) {
+        reflectProgram(shaderProgram);
+        programsFromCache++;
+        shaderMilliseconds += std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - loadStart).count();
+        return shaderProgram;
+    }
+    
     // Compile shaders
     GLuint vertexShader = compileShader(vertexSource, GL_VERTEX_SHADER);
     GLuint fragmentShader = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
@@ -134,9 +392,12 @@ GLuint Renderer::loadShader(const std::string& vertexPath, const std::string& fr
     }
     
     // Link shaders into program
-    GLuint shaderProgram = glCreateProgram();
+    shaderProgram = glCreateProgram();
     glAttachShader(shaderProgram, vertexShader);
     glAttachShader(shaderProgram, fragmentShader);
+    if (programBinariesSupported) {
+        glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(shaderProgram);
     
     // Check linking
@@ -154,9 +415,59 @@ GLuint Renderer::loadShader(const std::string& vertexPath, const std::string& fr
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
     
+    if (shaderProgram != 0) {
+        saveProgramBinary(shaderProgram, sourceKey);
+        reflectProgram(shaderProgram);
+        programsCompiled++;
+    }
+    shaderMilliseconds += std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - loadStart).count();
     return shaderProgram;
 }
 
+GLuint Renderer::loadProgramBinary(uint64_t sourceKey) {
+    const ProgramBinaryCache::Binary* binary = programBinariesSupported ? programCache.find(sourceKey) : nullptr;
+    if (binary == nullptr) {
+        return 0;
+    }
+    
+    // The driver may still reject a binary (e.g. after an update that kept its version
+    // string); then the program is compiled and the entry replaced
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, binary->format, binary->data.data(), static_cast<GLsizei>(binary->data.size()));
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        std::cout << "Program binary rejected by the driver, recompiling" << std::endl;
+        glDeleteProgram(program);
+        programCache.remove(sourceKey);
+        return 0;
+    }
+    return program;
+}
+
+void Renderer::saveProgramBinary(GLuint program, uint64_t sourceKey) {
+    if (!programBinariesSupported) {
+        return;
+    }
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    ProgramBinaryCache::Binary binary;
+    binary.data.resize(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data.data());
+    if (written <= 0) {
+        return;
+    }
+    binary.data.resize(static_cast<size_t>(written));
+    binary.format = format;
+    programCache.store(sourceKey, std::move(binary));
+}
+
 GLuint Renderer::compileShader(const std::string& source, GLenum shaderType) {
     GLuint shader = glCreateShader(shaderType);
     const char* sourceCStr = source.c_str();
@@ -177,8 +488,47 @@ GLuint Renderer::compileShader(const std::string& source, GLenum shaderType) {
     return shader;
 }
 
+// Binary PPM ("P6", 8-bit), the format of headless frame dumps, as RGBA rows from the
+// bottom up like GL expects
+static bool readPpm(const std::string& path, int& width, int& height, std::vector<unsigned char>& rgba) {
+    std::ifstream file(path, std::ios::binary);
+    std::string magic;
+    file >> magic;
+    int maxValue = 0;
+    int* fields[3] = {&width, &height, &maxValue};
+    for (int* field : fields) {
+        file >> std::ws;
+        while (file.peek() == '#') {
+            std::string comment;
+            std::getline(file, comment);
+            file >> std::ws;
+        }
+        file >> *field;
+    }
+    if (!file || magic != "P6" || width <= 0 || height <= 0 || maxValue != 255) {
+        return false;
+    }
+    file.get(); // Single whitespace before the samples
+    
+    std::vector<unsigned char> rgb(static_cast<size_t>(width) * height * 3);
+    if (!file.read(reinterpret_cast<char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()))) {
+        return false;
+    }
+    rgba.resize(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        const unsigned char* source = rgb.data() + static_cast<size_t>(height - 1 - y) * width * 3;
+        unsigned char* target = rgba.data() + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; x++) {
+            target[x * 4 + 0] = source[x * 3 + 0];
+            target[x * 4 + 1] = source[x * 3 + 1];
+            target[x * 4 + 2] = source[x * 3 + 2];
+            target[x * 4 + 3] = 255;
+        }
+    }
+    return true;
+}
+
 GLuint Renderer::loadTexture(const std::string& path) {
-    // This is a placeholder - you would use a library like stb_image to load actual textures
     GLuint texture;
     glGenTextures(1, &texture);
     glBindTexture(GL_TEXTURE_2D, texture);
@@ -189,9 +539,25 @@ GLuint Renderer::loadTexture(const std::string& path) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     
-    // For now, create a solid color texture as placeholder
+    // White until the file arrives, so the texture can be drawn right away
     unsigned char data[] = {255, 255, 255, 255}; // White
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    // Reading and decoding happen on the loader thread too; on failure the placeholder stays
+    assetLoader.submit([texture, path]() {
+        int width = 0, height = 0;
+        std::vector<unsigned char> rgba;
+        if (!readPpm(path, width, height, rgba)) {
+            std::cerr << "Failed to load texture: " << path << std::endl;
+            return;
+        }
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }, [this]() {
+        markAllLayersDirty();
+    });
     
     return texture;
 }
@@ -229,420 +595,1029 @@ GLuint Renderer::createCardTexture(int rank, int suit, bool isFront) {
     return texture;
 }
 
-void Renderer::renderCard(float x, float y, float width, float height, float rotation, GLuint texture) {
-    if (VAO == 0 || cardShaderProgram == 0) return;
+std::vector<int> Renderer::assignCardLayers(const std::vector<std::pair<int, int>>& faces) {
+    // One layer per unique face in order of first appearance; both cards of a pair share it
+    std::map<std::pair<int, int>, int> layerForFace;
+    std::vector<int> layers;
+    layers.reserve(faces.size());
+    for (const auto& face : faces) {
+        auto it = layerForFace.find(face);
+        if (it == layerForFace.end()) {
+            it = layerForFace.emplace(face, CARD_BACK_LAYER + 1 + static_cast<int>(layerForFace.size())).first;
+        }
+        layers.push_back(it->second);
+    }
+    return layers;
+}
+
+std::vector<int> Renderer::buildCardAtlas(const std::vector<std::pair<int, int>>& faces) {
+    std::vector<int> layers = assignCardLayers(faces);
+    int uniqueFaces = layers.empty() ? 0 : *std::max_element(layers.begin(), layers.end()) - CARD_BACK_LAYER;
+    
+    const int SIZE = Card::TEXTURE_SIZE;
+    int layersNeeded = 1 + uniqueFaces;
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    bool indexed = indexedFaces;
+    
+    // Jobs from the previous deal still reference their layers; let them finish first
+    waitForCardFaceJobs();
     
+    // (Re)allocate storage only when the deck outgrows it; the back is regenerated with it
+    bool reallocate = (cardAtlas == 0 || layersNeeded > cardAtlasLayers);
+    if (reallocate) {
+        releaseCardAtlas();
+        glGenTextures(1, &cardAtlas);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, cardAtlas);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        if (indexed) {
+            // Indices must not be interpolated; card_fragment.glsl filters after the palette lookup
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, SIZE, SIZE, layersNeeded, 0,
+                         GL_RED, GL_UNSIGNED_BYTE, nullptr);
+            
+            // One palette row per atlas layer
+            glGenTextures(1, &cardPalette);
+            glBindTexture(GL_TEXTURE_2D, cardPalette);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, CardRasterizer::PALETTE_SIZE, layersNeeded, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        } else {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, SIZE, SIZE, layersNeeded, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+        cardAtlasLayers = layersNeeded;
+        cardAtlasIndexed = indexed;
+    }
+    
+    // Only the back is needed for the first frame; faces are materialized on demand
+    atlasLayers.clear();
+    atlasLayers.resize(layersNeeded);
+    atlasLayers[CARD_BACK_LAYER].isFront = false;
+    atlasLayers[CARD_BACK_LAYER].uploaded = !reallocate;
+    for (size_t i = 0; i < faces.size(); i++) {
+        AtlasLayer& layer = atlasLayers[layers[i]];
+        layer.rank = faces[i].first;
+        layer.suit = faces[i].second;
+    }
+    if (reallocate) {
+        finishCardFace(CARD_BACK_LAYER);
+    }
+    
+    // Uploads cost this thread nothing with a loader, so every face starts streaming in
+    // now instead of when it is first turned over
+    bool streaming = assetLoader.isThreaded();
+    if (streaming) {
+        for (int layer = CARD_BACK_LAYER + 1; layer < layersNeeded; layer++) {
+            requestCardFace(layer);
+        }
+    }
+    
+    auto buildTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - buildStart);
+    std::cout << "Card atlas ready in " << buildTime.count() / 1000.0f << " ms ("
+              << (reallocate ? "allocated" : "reused") << ", " << uniqueFaces
+              << (streaming ? " faces streaming in" : " faces generated on demand");
+    if (cardCache.isOpen()) {
+        std::cout << " from the disk cache";
+    }
+    std::cout << "), " << (indexed ? "indexed R8" : "RGBA8") << " atlas uses "
+              << getCardAtlasBytes() / 1024 << " KB" << std::endl;
+    
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    return layers;
+}
+
+void Renderer::requestCardFace(int layer) {
+    if (layer < 0 || layer >= static_cast<int>(atlasLayers.size())) {
+        return;
+    }
+    AtlasLayer& entry = atlasLayers[layer];
+    if (entry.uploaded || entry.ready.valid() || entry.upload != 0) {
+        return;
+    }
+    
+    // Cached RGBA layers need no work at all; anything else is rasterized and/or
+    // palettized on the worker pool. Only uploads touch GL.
+    if (entry.isFront) {
+        entry.cached = cardCache.getFront(entry.rank, entry.suit);
+    } else {
+        entry.cached = cardCache.getBack();
+    }
+    if (entry.cached != nullptr && !cardAtlasIndexed) {
+        return;
+    }
+    bool indexed = cardAtlasIndexed;
+    entry.ready = texturePool.submit([&entry, indexed]() {
+        if (entry.cached == nullptr) {
+            entry.pixels = CardRasterizer::rasterize(entry.rank, entry.suit, entry.isFront);
+            entry.cached = entry.pixels.data();
+        }
+        if (indexed) {
+            entry.indices.resize(Card::TEXTURE_SIZE * Card::TEXTURE_SIZE);
+            entry.palette.resize(CardRasterizer::PALETTE_SIZE * 4);
+            CardRasterizer::palettize(entry.cached, entry.indices.data(), entry.palette.data());
+        }
+    });
+}
+
+void Renderer::finishCardFace(int layer) {
+    if (layer < 0 || layer >= static_cast<int>(atlasLayers.size()) || atlasLayers[layer].uploaded) {
+        return;
+    }
+    
+    // Already with the loader: waiting for it beats uploading the face a second time
+    AtlasLayer& entry = atlasLayers[layer];
+    if (entry.upload != 0) {
+        assetLoader.wait(entry.upload);
+        return;
+    }
+    requestCardFace(layer);
+    if (entry.ready.valid()) {
+        entry.ready.get();
+    }
+    uploadCardFace(layer);
+}
+
+void Renderer::uploadReadyCardFaces() {
+    // With a loader, everything ready this frame goes to it as one job; cached RGBA
+    // faces had no worker job and are ready as soon as they were requested
+    bool streaming = assetLoader.isThreaded();
+    std::vector<int> batch;
+    for (size_t layer = 0; layer < atlasLayers.size(); layer++) {
+        AtlasLayer& entry = atlasLayers[layer];
+        if (entry.uploaded || entry.upload != 0) {
+            continue;
+        }
+        if (entry.ready.valid()) {
+            if (entry.ready.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                continue;
+            }
+            entry.ready.get();
+        } else if (!streaming || entry.cached == nullptr) {
+            continue;
+        }
+        if (streaming) {
+            batch.push_back(static_cast<int>(layer));
+        } else {
+            uploadCardFace(static_cast<int>(layer));
+        }
+    }
+    if (!batch.empty()) {
+        queueCardFaceUploads(batch);
+    }
+}
+
+void Renderer::uploadCardFace(int layer) {
+    AtlasLayer& entry = atlasLayers[layer];
+    writeCardFace(cardAtlas, cardPalette, cardAtlasIndexed, layer,
+                  cardAtlasIndexed ? entry.indices.data() : entry.cached, entry.palette.data());
+    completeCardFace(layer);
+}
+
+void Renderer::queueCardFaceUploads(const std::vector<int>& layers) {
+    // The job only reads the entries' pixels; they stay put until completeCardFace,
+    // since the atlas is never rebuilt or released with uploads pending
+    struct FaceUpload {
+        int layer;
+        const unsigned char* pixels;
+        const unsigned char* paletteRow;
+    };
+    std::vector<FaceUpload> uploads;
+    for (int layer : layers) {
+        AtlasLayer& entry = atlasLayers[layer];
+        uploads.push_back({layer, cardAtlasIndexed ? entry.indices.data() : entry.cached, entry.palette.data()});
+    }
+    GLuint atlas = cardAtlas;
+    GLuint palette = cardPalette;
+    bool indexed = cardAtlasIndexed;
+    AssetLoader::Ticket ticket = assetLoader.submit([uploads, atlas, palette, indexed]() {
+        for (const FaceUpload& upload : uploads) {
+            writeCardFace(atlas, palette, indexed, upload.layer, upload.pixels, upload.paletteRow);
+        }
+    }, [this, layers]() {
+        for (int layer : layers) {
+            completeCardFace(layer);
+        }
+    });
+    for (int layer : layers) {
+        atlasLayers[layer].upload = ticket;
+    }
+}
+
+void Renderer::writeCardFace(GLuint atlas, GLuint palette, bool indexed, int layer,
+                             const unsigned char* pixels, const unsigned char* paletteRow) {
+    const int SIZE = Card::TEXTURE_SIZE;
+    glBindTexture(GL_TEXTURE_2D_ARRAY, atlas);
+    if (indexed) {
+        // 128-byte index rows keep the default 4-byte unpack alignment valid
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, SIZE, SIZE, 1,
+                        GL_RED, GL_UNSIGNED_BYTE, pixels);
+        glBindTexture(GL_TEXTURE_2D, palette);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, layer, CardRasterizer::PALETTE_SIZE, 1,
+                        GL_RGBA, GL_UNSIGNED_BYTE, paletteRow);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    } else {
+        // Straight from the file mapping when the cache is open
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, SIZE, SIZE, 1,
+                        GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void Renderer::completeCardFace(int layer) {
+    AtlasLayer& entry = atlasLayers[layer];
+    
+    // Cached cards may show this layer (a rebuilt atlas, a prefetched face)
+    markLayerDirty(Layer::BOARD);
+    markLayerDirty(Layer::ANIMATION);
+    
+    // The GPU has its copy; drop the CPU-side pixels
+    entry.uploaded = true;
+    entry.upload = 0;
+    entry.cached = nullptr;
+    std::vector<unsigned char>().swap(entry.pixels);
+    std::vector<unsigned char>().swap(entry.indices);
+    std::vector<unsigned char>().swap(entry.palette);
+}
+
+void Renderer::waitForCardFaceJobs() {
+    for (auto& entry : atlasLayers) {
+        if (entry.ready.valid()) {
+            entry.ready.wait();
+        }
+    }
+    assetLoader.finish();
+}
+
+void Renderer::releaseCardAtlas() {
+    waitForCardFaceJobs();
+    atlasLayers.clear();
+    if (cardAtlas != 0) {
+        glDeleteTextures(1, &cardAtlas);
+        cardAtlas = 0;
+    }
+    if (cardPalette != 0) {
+        glDeleteTextures(1, &cardPalette);
+        cardPalette = 0;
+    }
+    cardAtlasLayers = 0;
+}
+
+void Renderer::setProceduralFaces(bool enabled) {
+    if (enabled == proceduralFaces) {
+        return;
+    }
+    proceduralFaces = enabled;
+    markLayerDirty(Layer::BOARD);
+    markLayerDirty(Layer::ANIMATION);
+}
+
+void Renderer::setIndexedFaces(bool enabled) {
+    if (enabled == indexedFaces) {
+        return;
+    }
+    indexedFaces = enabled;
+    
+    // The atlas format changes, so drop it; the board rebuilds it on its next render
+    releaseCardAtlas();
+}
+
+size_t Renderer::getCardAtlasBytes() const {
+    size_t texels = static_cast<size_t>(Card::TEXTURE_SIZE) * Card::TEXTURE_SIZE * cardAtlasLayers;
+    if (cardAtlasIndexed) {
+        return texels + static_cast<size_t>(CardRasterizer::PALETTE_SIZE) * 4 * cardAtlasLayers;
+    }
+    return texels * 4;
+}
+
+void Renderer::bindCardAtlas() {
     glUseProgram(cardShaderProgram);
-    glBindVertexArray(VAO);
+    frameStats.programBinds++;
     
-    if (texture != 0) {
-        glBindTexture(GL_TEXTURE_2D, texture);
+    // Mode flags live in program state, so only re-upload them when they change
+    int procedural = proceduralFaces ? 1 : 0;
+    if (procedural != cardUniforms.proceduralValue && cardUniforms.proceduralFaces >= 0) {
+        glUniform1i(cardUniforms.proceduralFaces, procedural);
+        cardUniforms.proceduralValue = procedural;
+        frameStats.uniformUploads++;
+    }
+    if (proceduralFaces) {
+        return;
     }
     
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, cardAtlas);
     
+    // Indexed atlases resolve colors through the palette
+    int indexed = cardAtlasIndexed ? 1 : 0;
+    if (indexed != cardUniforms.indexedValue && cardUniforms.indexedFaces >= 0) {
+        glUniform1i(cardUniforms.indexedFaces, indexed);
+        cardUniforms.indexedValue = indexed;
+        frameStats.uniformUploads++;
+    }
+    if (cardAtlasIndexed) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, cardPalette);
+        glActiveTexture(GL_TEXTURE0);
+    }
+}
+
+void Renderer::drawCards(const std::vector<CardInstance>& instances) {
+    if (cardVAO == 0 || instances.empty()) return;
+    
+    // View and projection come from the camera block set in beginFrame
+    bindCardAtlas();
+    
+    // Copy the instances into this frame's part of the ring; there is no base instance
+    // in GL 3.3, so the instance attributes are pointed at the copy instead
+    GLintptr offset = streamBuffer.write(instances.data(), instances.size() * sizeof(CardInstance), sizeof(CardInstance));
+    if (offset < 0) return;
+    if (!streamBuffer.isPersistent()) {
+        frameStats.bufferUploads++; // Mapped and unmapped through the driver
+    }
+    
+    // The whole board in one draw call
+    glBindVertexArray(cardVAO);
+    pointCardInstances(offset);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, static_cast<GLsizei>(instances.size()));
     glBindVertexArray(0);
+    frameStats.drawCalls++;
 }
 
-void Renderer::renderText(const std::string& text, float x, float y, float scale) {
-    // Enhanced pixel-based text rendering with better visibility
-    // This creates clear, readable text on the OpenGL window
+void Renderer::beginFrame(const glm::mat4& view, const glm::mat4& projection) {
+    frameStats = GLCallStats();
+    frameBeginTime = std::chrono::steady_clock::now();
+    sceneRedrawn = false;
+    gpuProfiler.beginFrame();
+    assetLoader.poll();
     
-    glDisable(GL_DEPTH_TEST); // Render UI on top
+    // One upload serves every program that declares the Camera block; a still camera
+    // needs none, and cached layers invalidate when it moves
+    if (cameraUploaded && view == uploadedView && projection == uploadedProjection) {
+        return;
+    }
+    glm::mat4 matrices[2] = {view, projection};
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(matrices), &matrices[0][0][0]);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    frameStats.bufferUploads++;
+    if (cameraUploaded) {
+        markLayerDirty(Layer::BOARD);
+        markLayerDirty(Layer::ANIMATION);
+    }
+    uploadedView = view;
+    uploadedProjection = projection;
+    cameraUploaded = true;
+}
+
+void Renderer::endFrame() {
+    if (activeLayer >= 0) {
+        endLayer();
+    }
+    compositeLayers();
+    queueLoadingOverlay();
+    if (gpuTimingOverlay && gpuProfiler.isInitialized()) {
+        queueGpuTimingOverlay();
+    }
+    gpuProfiler.beginPass(PASS_OVERLAY);
+    flushSprites();
+    gpuProfiler.endPass();
+    lastFrameStats = frameStats;
+    
+    // Mark the end of this frame's commands; waitForFrameSlot checks it later
+    frameNumber++;
+    GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (sync != nullptr) {
+        frameFences.push_back({sync, frameNumber});
+    }
+    streamBuffer.endFrame();
+    
+    // Frames that only composite cached layers say nothing about the scaled layers' cost
+    if (sceneRedrawn) {
+        float frameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameBeginTime).count();
+        if (resolutionScaler.addFrame(frameMs + slotWaitMilliseconds)) {
+            markLayerDirty(Layer::BOARD);
+            markLayerDirty(Layer::ANIMATION);
+        }
+    }
+    slotWaitMilliseconds = 0.0f;
+}
+
+void Renderer::setFrameBudget(float milliseconds) {
+    float scale = resolutionScaler.getScale();
+    resolutionScaler.setBudget(milliseconds);
+    if (resolutionScaler.getScale() != scale) {
+        markLayerDirty(Layer::BOARD);
+        markLayerDirty(Layer::ANIMATION);
+    }
+}
+
+void Renderer::waitForFrameSlot() {
+    // Retire finished frames without blocking
+    while (!frameFences.empty()) {
+        GLenum state = glClientWaitSync(frameFences.front().sync, 0, 0);
+        if (state != GL_ALREADY_SIGNALED && state != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        completedFrame = frameFences.front().frame;
+        glDeleteSync(frameFences.front().sync);
+        frameFences.pop_front();
+    }
     
+    // Bounded pipeline: block on the oldest frames until a slot is free. The flush bit
+    // makes sure the fence is actually submitted, or the wait could never end.
+    auto waitStart = std::chrono::steady_clock::now();
+    bool waited = false;
+    while (maxFramesInFlight > 0 && static_cast<int>(frameFences.size()) >= maxFramesInFlight) {
+        waited = true;
+        GLenum state = glClientWaitSync(frameFences.front().sync, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000); // 100 ms
+        if (state == GL_TIMEOUT_EXPIRED) {
+            continue;
+        }
+        if (state != GL_WAIT_FAILED) {
+            completedFrame = frameFences.front().frame;
+        }
+        glDeleteSync(frameFences.front().sync);
+        frameFences.pop_front();
+    }
+    if (waited) {
+        slotWaitMilliseconds += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
+    }
+}
+
+void Renderer::releaseFrameFences() {
+    for (const FrameFence& fence : frameFences) {
+        glDeleteSync(fence.sync);
+    }
+    frameFences.clear();
+}
+
+void Renderer::setBackgroundColor(const glm::vec4& color) {
+    backgroundColor = color;
+    glClearColor(color.x, color.y, color.z, color.w);
+    markLayerDirty(Layer::BOARD);
+}
+
+void Renderer::markLayerDirty(Layer layer) {
+    renderLayers[static_cast<int>(layer)].dirty = true;
+}
+
+void Renderer::markLayerRegionDirty(Layer layer, int x, int y, int width, int height) {
+    RenderLayer& target = renderLayers[static_cast<int>(layer)];
+    if (target.dirty || width <= 0 || height <= 0) {
+        return; // Redrawn whole anyway
+    }
+    if (!target.regionDirty) {
+        target.regionX0 = x;
+        target.regionY0 = y;
+        target.regionX1 = x + width;
+        target.regionY1 = y + height;
+        target.regionDirty = true;
+        return;
+    }
+    target.regionX0 = std::min(target.regionX0, x);
+    target.regionY0 = std::min(target.regionY0, y);
+    target.regionX1 = std::max(target.regionX1, x + width);
+    target.regionY1 = std::max(target.regionY1, y + height);
+}
+
+void Renderer::markAllLayersDirty() {
+    for (RenderLayer& layer : renderLayers) {
+        layer.dirty = true;
+    }
+}
+
+bool Renderer::createLayers() {
+    int width = static_cast<int>(viewportWidth);
+    int height = static_cast<int>(viewportHeight);
+    float scale = resolutionScaler.getScale();
+    int sceneWidth = std::max(1, static_cast<int>(width * scale + 0.5f));
+    int sceneHeight = std::max(1, static_cast<int>(height * scale + 0.5f));
+    
+    // A new size (or first use) reallocates the layer, which must then be redrawn
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        RenderLayer& layer = renderLayers[i];
+        bool scene = i != static_cast<int>(Layer::HUD);
+        int layerWidth = scene ? sceneWidth : width;
+        int layerHeight = scene ? sceneHeight : height;
+        if (layer.framebuffer != 0 && layer.width == layerWidth && layer.height == layerHeight) {
+            continue;
+        }
+        if (!allocateLayer(layer, layerWidth, layerHeight)) {
+            releaseLayers();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Renderer::allocateLayer(RenderLayer& layer, int width, int height) {
+    releaseLayer(layer);
+    
+    // The composite samples at window pixel centers: a full-size layer maps texel for
+    // texel, a scaled one is filtered up
+    bool scaled = width != static_cast<int>(viewportWidth) || height != static_cast<int>(viewportHeight);
+    GLint filter = scaled ? GL_LINEAR : GL_NEAREST;
+    glGenTextures(1, &layer.texture);
+    glBindTexture(GL_TEXTURE_2D, layer.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    // Color only: cards within a layer never overlap, so no depth buffer is needed
+    glGenFramebuffers(1, &layer.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, layer.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, layer.texture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Layer framebuffer incomplete: 0x" << std::hex << status << std::dec << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+        releaseLayer(layer);
+        return false;
+    }
+    
+    // Start transparent, so a layer that is never drawn composites as nothing
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(backgroundColor.x, backgroundColor.y, backgroundColor.z, backgroundColor.w);
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+    layer.width = width;
+    layer.height = height;
+    return true;
+}
+
+void Renderer::releaseLayer(RenderLayer& layer) {
+    if (layer.framebuffer != 0) {
+        glDeleteFramebuffers(1, &layer.framebuffer);
+        layer.framebuffer = 0;
+    }
+    if (layer.texture != 0) {
+        glDeleteTextures(1, &layer.texture);
+        layer.texture = 0;
+    }
+    layer.width = 0;
+    layer.height = 0;
+    layer.dirty = true;
+    layer.regionDirty = false;
+}
+
+void Renderer::releaseLayers() {
+    for (RenderLayer& layer : renderLayers) {
+        releaseLayer(layer);
+    }
+    activeLayer = -1;
+}
+
+bool Renderer::beginLayer(Layer layer) {
+    if (compositeProgram == 0 || !createLayers()) {
+        return true; // No compositor: draw straight to the window every frame
+    }
+    RenderLayer& target = renderLayers[static_cast<int>(layer)];
+    if (!target.dirty && !target.regionDirty) {
+        return false;
+    }
+    
+    // Sprites queued so far belong to whatever was bound before
+    flushSprites();
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glViewport(0, 0, target.width, target.height);
+    if (!target.dirty) {
+        // The scissor limits the clear as well as the draws; on a scaled layer the
+        // region grows to whole texels
+        float scaleX = target.width / viewportWidth;
+        float scaleY = target.height / viewportHeight;
+        int x0 = static_cast<int>(std::floor(target.regionX0 * scaleX));
+        int y0 = static_cast<int>(std::floor(target.regionY0 * scaleY));
+        int x1 = static_cast<int>(std::ceil(target.regionX1 * scaleX));
+        int y1 = static_cast<int>(std::ceil(target.regionY1 * scaleY));
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x0, y0, x1 - x0, y1 - y0);
+    }
+    if (layer == Layer::BOARD) {
+        glClear(GL_COLOR_BUFFER_BIT); // Opaque background
+    } else {
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glClearColor(backgroundColor.x, backgroundColor.y, backgroundColor.z, backgroundColor.w);
+    }
+    activeLayer = static_cast<int>(layer);
+    if (layer != Layer::HUD) {
+        sceneRedrawn = true;
+    }
+    gpuProfiler.beginPass(activeLayer); // The clear is part of the layer's cost
+    return true;
+}
+
+void Renderer::endLayer() {
+    if (activeLayer < 0) {
+        return;
+    }
+    flushSprites();
+    gpuProfiler.endPass();
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+    glViewport(0, 0, static_cast<GLsizei>(viewportWidth), static_cast<GLsizei>(viewportHeight));
+    renderLayers[activeLayer].dirty = false;
+    renderLayers[activeLayer].regionDirty = false;
+    activeLayer = -1;
+    frameStats.layersRedrawn++;
+}
+
+void Renderer::compositeLayers() {
+    if (renderLayers[0].framebuffer == 0) {
+        return; // Nothing has been drawn into layers
+    }
+    
+    // Every layer covers the whole viewport: one triangle reads all three, no blending
+    gpuProfiler.beginPass(PASS_COMPOSITE);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    const RenderLayer& hud = renderLayers[static_cast<int>(Layer::HUD)];
+    bool scaled = renderLayers[0].width != hud.width || renderLayers[0].height != hud.height;
+    glUseProgram(scaled ? compositeScaledProgram : compositeProgram);
+    frameStats.programBinds++;
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, renderLayers[i].texture);
+    }
+    glBindVertexArray(compositeVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    frameStats.drawCalls++;
+    
+    // Unbind so no later draw into a layer can sample its own attachment
+    for (int i = LAYER_COUNT - 1; i >= 0; i--) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glEnable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    gpuProfiler.endPass();
+}
+
+GLint Renderer::getUniformLocation(GLuint program, const std::string& name) const {
+    auto programIt = programUniforms.find(program);
+    if (programIt == programUniforms.end()) return -1;
+    auto it = programIt->second.find(name);
+    return it == programIt->second.end() ? -1 : it->second;
+}
+
+void Renderer::reflectProgram(GLuint program) {
+    // Resolve every active uniform once; draws then use the cached locations
+    std::unordered_map<std::string, GLint>& locations = programUniforms[program];
+    locations.clear();
+    
+    GLint uniformCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    for (GLint i = 0; i < uniformCount; i++) {
+        char name[128];
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, static_cast<GLuint>(i), sizeof(name), &length, &size, &type, name);
+        std::string uniformName(name, length);
+        size_t bracket = uniformName.find('[');
+        if (bracket != std::string::npos) {
+            uniformName.resize(bracket); // "array[0]" is also reachable as "array"
+        }
+        GLint location = glGetUniformLocation(program, name);
+        if (location >= 0) {
+            locations[uniformName] = location; // Block members have no location
+        }
+    }
+    
+    // Attach the shared camera block to its fixed binding point
+    GLuint cameraBlock = glGetUniformBlockIndex(program, "Camera");
+    if (cameraBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, cameraBlock, CAMERA_BINDING);
+    }
+}
+
+void Renderer::printFrameStats() const {
+    const GLCallStats& stats = lastFrameStats;
+    std::cout << "GL calls last frame: " << stats.drawCalls << " draws, "
+              << stats.programBinds << " program binds, "
+              << stats.uniformUploads << " uniform uploads, "
+              << stats.textureUploads << " texture uploads, "
+              << stats.bufferUploads << " buffer uploads, "
+              << stats.layersRedrawn << " of " << LAYER_COUNT << " layers redrawn" << std::endl;
+    if (resolutionScaler.isEnabled()) {
+        const RenderLayer& board = renderLayers[static_cast<int>(Layer::BOARD)];
+        std::cout << "Dynamic resolution: scale " << resolutionScaler.getScale() << " (board " << board.width << "x"
+                  << board.height << "), " << resolutionScaler.getLastAverage() << " ms redraw frames against a "
+                  << resolutionScaler.getBudget() << " ms budget, " << resolutionScaler.getChanges() << " changes" << std::endl;
+    }
+}
+
+void Renderer::setGpuProfiling(bool enabled) {
+    if (!enabled) {
+        gpuProfiler.release();
+        return;
+    }
+    if (gpuProfiler.isInitialized()) {
+        return;
+    }
+    if (!gpuProfiler.initialize({"board", "animation", "hud", "composite", "overlay"})) {
+        std::cerr << "Failed to create GPU timer queries" << std::endl;
+    }
+}
+
+void Renderer::printGpuTimings() const {
+    if (!gpuProfiler.isInitialized()) {
+        std::cout << "GPU timing is off" << std::endl;
+        return;
+    }
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3) << "GPU time per pass (ms, last / average / max):" << std::endl;
+    for (int pass = 0; pass < gpuProfiler.getPassCount(); pass++) {
+        const GpuProfiler::RollingStats& stats = gpuProfiler.getStats(pass);
+        report << "  " << std::left << std::setw(10) << gpuProfiler.getPassName(pass) << std::right
+               << stats.getLast() << " / " << stats.getAverage() << " / " << stats.getMax()
+               << " (" << stats.getCount() << " samples)" << std::endl;
+    }
+    if (gpuProfiler.getDroppedResults() > 0) {
+        report << "  " << gpuProfiler.getDroppedResults() << " results not ready after "
+               << GpuProfiler::FRAMES_IN_FLIGHT << " frames were dropped" << std::endl;
+    }
+    std::cout << report.str();
+}
+
+void Renderer::queueGpuTimingOverlay() {
+    // Averages only: they change slowly enough to read. Drawn outside the layers, so
+    // showing them never dirties the cached HUD.
+    char line[64];
+    float y = 0.9f;
+    for (int pass = 0; pass < gpuProfiler.getPassCount(); pass++) {
+        const GpuProfiler::RollingStats& stats = gpuProfiler.getStats(pass);
+        std::snprintf(line, sizeof(line), "%-10s%5.2f ms", gpuProfiler.getPassName(pass).c_str(), stats.getAverage());
+        renderEnhancedText(line, 0.38f, y, 0.7f);
+        y -= 0.07f;
+    }
+}
+
+void Renderer::queueLoadingOverlay() {
+    // Faces on their way: with a worker or with the loader. Only a loader streams
+    // whole decks; without it faces are made one flip at a time, which is no loading.
+    int faces = 0;
+    int uploaded = 0;
+    bool streaming = false;
+    for (size_t layer = CARD_BACK_LAYER + 1; layer < atlasLayers.size(); layer++) {
+        const AtlasLayer& entry = atlasLayers[layer];
+        faces++;
+        uploaded += entry.uploaded ? 1 : 0;
+        streaming = streaming || entry.ready.valid() || entry.upload != 0;
+    }
+    bool loading = assetLoader.isThreaded() && (streaming || assetLoader.getPending() > 0);
+    loadingAssets = loading;
+    if (!loading || !loadingOverlay) {
+        return;
+    }
+    char line[48];
+    std::snprintf(line, sizeof(line), "Loading faces %d/%d", uploaded, faces);
+    renderEnhancedText(line, -0.95f, -0.92f, 0.7f);
+}
+
+bool Renderer::startAssetLoader(std::function<bool()> makeCurrent, std::function<void()> release) {
+    return assetLoader.start(std::move(makeCurrent), std::move(release));
+}
+
+void Renderer::renderCard(float x, float y, float width, float height, float rotation, GLuint texture) {
+    // A whole-texture sprite in overlay space, rotated by degrees around its center
+    pushSprite(textShaderProgram, texture, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), x, y, width, height, glm::vec4(1.0f), rotation);
+}
+
+bool Renderer::buildFontAtlas(FontAtlas& font, const unsigned char* coverage, int glyphSize, GLint filter) {
+    // The cells were laid out and flipped at compile time (BitmapFont); only the
+    // texture coordinates of each cell are derived here
+    const float width = static_cast<float>(BitmapFont::atlasWidth(glyphSize));
+    const float height = static_cast<float>(BitmapFont::atlasHeight(glyphSize));
+    auto cellRect = [&](int cell) {
+        float originX = static_cast<float>(BitmapFont::cellOriginX(glyphSize, cell));
+        float originY = static_cast<float>(BitmapFont::cellOriginY(glyphSize, cell));
+        return glm::vec4(originX / width, originY / height, (originX + glyphSize) / width, (originY + glyphSize) / height);
+    };
+    for (int code = 0; code < FONT_GLYPHS; code++) {
+        font.glyphRect[code] = cellRect(code);
+    }
+    
+    // Solid cell; panels sample its center so filtering never reaches the gutter
+    glm::vec4 solid = cellRect(BitmapFont::SOLID_CELL);
+    glm::vec2 center = (glm::vec2(solid.x, solid.y) + glm::vec2(solid.z, solid.w)) * 0.5f;
+    font.solidRect = glm::vec4(center.x, center.y, center.x, center.y);
+    font.glyphSize = glyphSize;
+    
+    // Coverage only: the swizzle makes it read as white with coverage as alpha,
+    // which is what the text shader tints
+    const GLint swizzle[4] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+    glGenTextures(1, &font.texture);
+    glBindTexture(GL_TEXTURE_2D, font.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, BitmapFont::atlasWidth(glyphSize), BitmapFont::atlasHeight(glyphSize), 0,
+                 GL_RED, GL_UNSIGNED_BYTE, coverage);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return font.texture != 0;
+}
+
+void Renderer::releaseFontAtlas(FontAtlas& font) {
+    if (font.texture != 0) {
+        glDeleteTextures(1, &font.texture);
+        font.texture = 0;
+    }
+}
+
+const glm::vec4& Renderer::FontAtlas::rectFor(char c) const {
+    // Anything outside ASCII falls back to DEL, which draws the unknown-character block
+    unsigned char code = static_cast<unsigned char>(c);
+    return glyphRect[code < FONT_GLYPHS ? code : FONT_GLYPHS - 1];
+}
+
+void Renderer::pushSprite(GLuint program, GLuint texture, const glm::vec4& rect, float centerX, float centerY,
+                          float width, float height, const glm::vec4& color, float rotation) {
+    // Extend the last run when program and texture match, so submission order is kept with few draws
+    if (spriteRuns.empty() || spriteRuns.back().program != program || spriteRuns.back().texture != texture) {
+        spriteRuns.push_back({program, texture, spriteVertices.size() / 4, 0});
+    }
+    spriteRuns.back().quadCount++;
+    
+    unsigned char rgba[4];
+    for (int i = 0; i < 4; i++) {
+        rgba[i] = static_cast<unsigned char>(std::clamp(color[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+    
+    // Corners in quad order (bottom-left, bottom-right, top-right, top-left), matching quadIndices
+    const float corners[4][2] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    float cosAngle = std::cos(glm::radians(rotation));
+    float sinAngle = std::sin(glm::radians(rotation));
+    for (const auto& corner : corners) {
+        float dx = (corner[0] - 0.5f) * width;
+        float dy = (corner[1] - 0.5f) * height;
+        SpriteVertex vertex;
+        vertex.x = centerX + dx * cosAngle - dy * sinAngle;
+        vertex.y = centerY + dx * sinAngle + dy * cosAngle;
+        vertex.u = rect.x + (rect.z - rect.x) * corner[0];
+        vertex.v = rect.y + (rect.w - rect.y) * corner[1];
+        vertex.quadU = corner[0];
+        vertex.quadV = corner[1];
+        std::copy(rgba, rgba + 4, vertex.color);
+        spriteVertices.push_back(vertex);
+    }
+}
+
+void Renderer::pointCardInstances(GLintptr offset) {
+    // Called with cardVAO bound; the bindings are VAO state, so nothing else changes
+    glBindBuffer(GL_ARRAY_BUFFER, streamBuffer.getBuffer());
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(CardInstance), (void*)(offset + offsetof(CardInstance, x)));
+    glVertexAttribIPointer(3, 4, GL_INT, sizeof(CardInstance), (void*)(offset + offsetof(CardInstance, layer)));
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(CardInstance), (void*)(offset + offsetof(CardInstance, patternColor)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Renderer::pointSpriteVertices() {
+    // Called with spriteVAO bound; draws select their vertices with a base vertex
+    glBindBuffer(GL_ARRAY_BUFFER, streamBuffer.getBuffer());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, x));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, u));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, quadU));
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, color));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    spriteBufferGeneration = streamBuffer.getGeneration();
+}
+
+void Renderer::flushSprites() {
+    if (spriteVAO == 0 || spriteVertices.empty()) return;
+    
+    size_t quadCount = spriteVertices.size() / 4;
+    
+    // Copy the batch into the ring at a whole-vertex offset, so each draw can address it
+    // with a base vertex; the static index buffer grows with the largest batch
+    GLintptr offset = streamBuffer.write(spriteVertices.data(), spriteVertices.size() * sizeof(SpriteVertex), sizeof(SpriteVertex));
+    if (offset < 0) return;
+    if (!streamBuffer.isPersistent()) {
+        frameStats.bufferUploads++;
+    }
+    GLint baseVertex = static_cast<GLint>(offset / sizeof(SpriteVertex));
+    glBindVertexArray(spriteVAO);
+    if (spriteBufferGeneration != streamBuffer.getGeneration()) {
+        pointSpriteVertices(); // The ring was reallocated
+    }
+    if (quadCount > spriteCapacity) {
+        spriteCapacity = std::max(quadCount, spriteCapacity * 2);
+        std::vector<GLuint> indices(spriteCapacity * 6);
+        for (size_t quad = 0; quad < spriteCapacity; quad++) {
+            for (int i = 0; i < 6; i++) {
+                indices[quad * 6 + i] = static_cast<GLuint>(quad * 4 + quadIndices[i]);
+            }
+        }
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+        frameStats.bufferUploads++;
+    }
+    // UI draws on top of everything; positions are already in overlay space
+    glDisable(GL_DEPTH_TEST);
+    glActiveTexture(GL_TEXTURE0); // Both UI programs sample unit 0
+    
+    // One draw per run of sprites sharing a program and texture
+    GLuint boundProgram = 0;
+    for (const SpriteRun& run : spriteRuns) {
+        if (run.program != boundProgram) {
+            glUseProgram(run.program);
+            frameStats.programBinds++;
+            boundProgram = run.program;
+        }
+        glBindTexture(GL_TEXTURE_2D, run.texture);
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(run.quadCount * 6), GL_UNSIGNED_INT,
+                                 (void*)(run.firstQuad * 6 * sizeof(GLuint)), baseVertex);
+        frameStats.drawCalls++;
+    }
+    
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
+    
+    spriteVertices.clear();
+    spriteRuns.clear();
+}
+
+void Renderer::queueSdfText(const std::string& text, float x, float y, float charWidth, float charHeight,
+                            float spacing, const glm::vec4& color) {
+    // Atlas pixels to overlay units: the baked line height (ascent to descent) fills charHeight
+    float pixels = charHeight * viewportHeight * 0.5f / SdfFont::PIXEL_HEIGHT;
+    float unitX = pixels * 2.0f / viewportWidth;
+    float unitY = pixels * 2.0f / viewportHeight;
+    float baseline = y - sdfFont.getDescent() * unitY;
+    
+    // Fixed cells keep the layout (and panel widths) of the pixel fonts; glyphs are centered in them
+    float renderX = x;
+    for (size_t i = 0; i < text.length(); i++) {
+        const FontGlyph& glyph = sdfFont.getGlyph(text[i]);
+        if (text[i] != ' ' && glyph.width > 0) {
+            float originX = renderX + (charWidth - glyph.advance * unitX) * 0.5f;
+            float left = originX + glyph.xOffset * unitX;
+            float top = baseline - glyph.yOffset * unitY;
+            float width = glyph.width * unitX;
+            float height = glyph.height * unitY;
+            // Bitmap rows run top to bottom, so the quad's bottom edge samples v1
+            pushSprite(sdfShaderProgram, sdfFontAtlas, glm::vec4(glyph.u0, glyph.v1, glyph.u1, glyph.v0),
+                       left + width * 0.5f, top - height * 0.5f, width, height, color);
+        }
+        renderX += spacing;
+    }
+}
+
+void Renderer::renderText(const std::string& text, float x, float y, float scale) {
+    // Enhanced pixel-based text rendering with better visibility
+    // Glyph quads are queued and drawn by flushSprites
     float charWidth = 0.04f * scale;   // Slightly larger characters
     float charHeight = 0.06f * scale;
     float spacing = charWidth * 1.15f; // Better spacing
     
+    // TrueType glyphs get their outline and shadow from the distance field shader
+    if (sdfFontAtlas != 0) {
+        queueSdfText(text, x, y, charWidth, charHeight, spacing, glm::vec4(1.0f));
+        return;
+    }
+    if (basicFont.texture == 0) return;
+    
     // First pass: render black outline/shadow for better readability
     float shadowOffset = 0.003f * scale;
     for (int shadowPass = 0; shadowPass < 2; shadowPass++) {
         float renderX = x + (shadowPass == 0 ? shadowOffset : 0);
         float renderY = y - (shadowPass == 0 ? shadowOffset : 0);
         bool isMainText = (shadowPass == 1);
-    
-        // Create orthographic projection for UI rendering
-        glm::mat4 orthoProjection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-        glm::mat4 view = glm::mat4(1.0f);
+        
+        // White text over a black shadow
+        glm::vec4 color = isMainText ? glm::vec4(1.0f) : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
         
         for (size_t i = 0; i < text.length(); i++) {
             char c = text[i];
-            if (c == ' ') {
-                renderX += spacing;
-                continue;
-            }
-            
-            // Create a larger bitmap texture for each character
-            const int CHAR_SIZE = 12; // Increased for better quality
-            unsigned char charBitmap[CHAR_SIZE * CHAR_SIZE * 4]; // RGBA
-            
-            // Fill with transparent background
-            for (int j = 0; j < CHAR_SIZE * CHAR_SIZE * 4; j += 4) {
-                if (isMainText) {
-                    charBitmap[j] = 255;     // R - White text
-                    charBitmap[j+1] = 255;   // G  
-                    charBitmap[j+2] = 255;   // B
-                } else {
-                    charBitmap[j] = 0;       // R - Black shadow
-                    charBitmap[j+1] = 0;     // G
-                    charBitmap[j+2] = 0;     // B
-                }
-                charBitmap[j+3] = 0;         // A (transparent)
-            }
-        
-            // Draw character pattern (enhanced pixel art for 12x12)
-            switch (c) {
-                case '0': case 'O':
-                    // Draw O shape
-                    for (int row = 2; row < 10; row++) {
-                        for (int col = 2; col < 10; col++) {
-                            if ((row == 2 || row == 9) && (col > 3 && col < 8)) {
-                                charBitmap[(row * CHAR_SIZE + col) * 4 + 3] = 255;
-                            } else if ((col == 2 || col == 9) && (row > 3 && row < 8)) {
-                                charBitmap[(row * CHAR_SIZE + col) * 4 + 3] = 255;
-                            } else if ((row == 3 || row == 8) && (col == 3 || col == 8)) {
-                                charBitmap[(row * CHAR_SIZE + col) * 4 + 3] = 255;
-                            }
-                        }
-                    }
-                    break;
-                case '1': case 'I': case 'l':
-                    // Draw I/1 shape
-                    for (int row = 1; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 5) * 4 + 3] = 255;
-                        charBitmap[(row * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    }
-                    // Add serifs for better visibility
-                    for (int col = 4; col < 8; col++) {
-                        charBitmap[(1 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    break;
-                case '2':
-                    // Draw 2 shape
-                    for (int col = 2; col < 9; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    // Right side top
-                    for (int row = 3; row < 6; row++) {
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    }
-                    // Left side bottom
-                    for (int row = 7; row < 10; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255;
-                    }
-                    break;
-                case '3':
-                    // Draw 3 shape
-                    for (int col = 2; col < 8; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 3; row < 10; row++) {
-                        if (row != 6) charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right side
-                    }
-                    break;
-                case '4':
-                    // Draw 4 shape
-                    for (int row = 2; row < 7; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side
-                    }
-                    for (int col = 2; col < 9; col++) {
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                    }
-                    for (int row = 2; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right side
-                    }
-                    break;
-                case '5': case 'S': 
-                    // Draw 5/S shape
-                    for (int col = 2; col < 8; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 3; row < 6; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side top
-                    }
-                    for (int row = 7; row < 10; row++) {
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right side bottom
-                    }
-                    break;
-                case '6':
-                    // Draw 6 shape (enhanced for 12x12)
-                    for (int col = 2; col < 8; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 3; row < 10; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side
-                    }
-                    for (int row = 7; row < 10; row++) {
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right side bottom
-                    }
-                    break;
-                case '7':
-                    // Draw 7 shape  
-                    for (int col = 2; col < 9; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                    }
-                    for (int row = 3; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right side
-                    }
-                    break;
-                case '8':
-                    // Draw 8 shape (enhanced)
-                    for (int col = 2; col < 8; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 3; row < 10; row++) {
-                        if (row != 6) {
-                            charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side
-                            charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right side
-                        }
-                    }
-                    break;
-                case '9':
-                    // Draw 9 shape (enhanced)
-                    for (int col = 2; col < 8; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 3; row < 6; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side top
-                    }
-                    for (int row = 3; row < 10; row++) {
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right side
-                    }
-                    break;
-                case 'T': case 't':
-                    // Draw T shape (enhanced)
-                    for (int col = 1; col < 10; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                    }
-                    for (int row = 3; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 5) * 4 + 3] = 255; // center vertical
-                        charBitmap[(row * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    }
-                    break;
-                case 'M': case 'm':
-                    // Draw M shape (enhanced)
-                    for (int row = 2; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 1) * 4 + 3] = 255; // left
-                        charBitmap[(row * CHAR_SIZE + 9) * 4 + 3] = 255; // right
-                    }
-                    // Middle peaks  
-                    charBitmap[(3 * CHAR_SIZE + 3) * 4 + 3] = 255;
-                    charBitmap[(3 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(4 * CHAR_SIZE + 4) * 4 + 3] = 255;
-                    charBitmap[(4 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(5 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    break;
-                case 'E': case 'e':
-                    // Draw E shape (enhanced)
-                    for (int row = 2; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side
-                    }
-                    for (int col = 2; col < 8; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    break;
-                case 'V': case 'v':
-                    // Draw V shape (enhanced)
-                    for (int row = 2; row < 7; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right
-                    }
-                    charBitmap[(7 * CHAR_SIZE + 3) * 4 + 3] = 255;
-                    charBitmap[(7 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(8 * CHAR_SIZE + 4) * 4 + 3] = 255;
-                    charBitmap[(8 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    break;
-                case 'C': case 'c':
-                    // Draw C shape (enhanced)
-                    for (int col = 3; col < 8; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 3; row < 10; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side
-                    }
-                    break;
-                case 'R': case 'r':
-                    // Draw R shape (enhanced)
-                    for (int row = 2; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side
-                    }
-                    for (int col = 2; col < 7; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255; // top
-                        charBitmap[(6 * CHAR_SIZE + col) * 4 + 3] = 255; // middle
-                    }
-                    for (int row = 3; row < 6; row++) {
-                        charBitmap[(row * CHAR_SIZE + 7) * 4 + 3] = 255; // right side top
-                    }
-                    // Diagonal leg
-                    charBitmap[(7 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(8 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    break;
-                case 'Y': case 'y':
-                    // Draw Y shape (enhanced)
-                    charBitmap[(2 * CHAR_SIZE + 2) * 4 + 3] = 255; // top left
-                    charBitmap[(2 * CHAR_SIZE + 8) * 4 + 3] = 255; // top right
-                    charBitmap[(3 * CHAR_SIZE + 3) * 4 + 3] = 255; // converging
-                    charBitmap[(3 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(4 * CHAR_SIZE + 4) * 4 + 3] = 255;
-                    charBitmap[(4 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    for (int row = 5; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 5) * 4 + 3] = 255; // center vertical
-                    }
-                    break;
-                case 'U': case 'u':
-                    // Draw U shape (enhanced)
-                    for (int row = 2; row < 9; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left side
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right side
-                    }
-                    for (int col = 3; col < 8; col++) {
-                        charBitmap[(9 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                        charBitmap[(10 * CHAR_SIZE + col) * 4 + 3] = 255;
-                    }
-                    break;
-                case 'W': case 'w':
-                    // Draw W shape (enhanced)
-                    for (int row = 2; row < 9; row++) {
-                        charBitmap[(row * CHAR_SIZE + 1) * 4 + 3] = 255; // left
-                        charBitmap[(row * CHAR_SIZE + 9) * 4 + 3] = 255; // right
-                    }
-                    charBitmap[(7 * CHAR_SIZE + 5) * 4 + 3] = 255; // middle peak
-                    charBitmap[(8 * CHAR_SIZE + 3) * 4 + 3] = 255; // middle supports
-                    charBitmap[(8 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 4) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 5) * 4 + 3] = 255; // bottom center
-                    break;
-                case 'N': case 'n':
-                    // Draw N shape (enhanced)
-                    for (int row = 2; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255; // left
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255; // right
-                        if (row > 2 && row < 10) {
-                            int diagCol = 2 + (row - 2);
-                            if (diagCol < 8) {
-                                charBitmap[(row * CHAR_SIZE + diagCol) * 4 + 3] = 255; // diagonal
-                            }
-                        }
-                    }
-                    break;
-                case ':':
-                    // Draw colon (enhanced)
-                    charBitmap[(4 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(4 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(5 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(5 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(7 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(7 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(8 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(8 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    break;
-                case '!':
-                    // Draw exclamation mark (enhanced)
-                    for (int row = 2; row < 8; row++) {
-                        charBitmap[(row * CHAR_SIZE + 5) * 4 + 3] = 255;
-                        charBitmap[(row * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    }
-                    charBitmap[(9 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    break;
-                default:
-                    // Draw a small rectangle for unknown characters (enhanced)
-                    for (int row = 4; row < 8; row++) {
-                        for (int col = 3; col < 8; col++) {
-                            charBitmap[(row * CHAR_SIZE + col) * 4 + 3] = 255;
-                        }
-                    }
-                    break;
-            }
-        
-            // Flip the bitmap vertically to fix mirroring issue
-            unsigned char flippedBitmap[CHAR_SIZE * CHAR_SIZE * 4];
-            for (int row = 0; row < CHAR_SIZE; row++) {
-                for (int col = 0; col < CHAR_SIZE; col++) {
-                    int srcIndex = (row * CHAR_SIZE + col) * 4;
-                    int dstIndex = ((CHAR_SIZE - 1 - row) * CHAR_SIZE + col) * 4;
-                    flippedBitmap[dstIndex + 0] = charBitmap[srcIndex + 0];
-                    flippedBitmap[dstIndex + 1] = charBitmap[srcIndex + 1];
-                    flippedBitmap[dstIndex + 2] = charBitmap[srcIndex + 2];
-                    flippedBitmap[dstIndex + 3] = charBitmap[srcIndex + 3];
-                }
-            }
-            
-            // Create texture from flipped bitmap
-            GLuint charTexture;
-            glGenTextures(1, &charTexture);
-            glBindTexture(GL_TEXTURE_2D, charTexture);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, CHAR_SIZE, CHAR_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, flippedBitmap);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            
-            // Render the character quad
-            glUseProgram(cardShaderProgram);
-            
-            // Set up model matrix for the character
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, glm::vec3(renderX + charWidth/2, renderY + charHeight/2, 0.1f));
-            model = glm::scale(model, glm::vec3(charWidth, charHeight, 1.0f));
-            
-            // Set uniforms
-            GLint modelLoc = glGetUniformLocation(cardShaderProgram, "model");
-            GLint viewLoc = glGetUniformLocation(cardShaderProgram, "view");
-            GLint projLoc = glGetUniformLocation(cardShaderProgram, "projection");
-            
-            if (modelLoc >= 0) glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
-            if (viewLoc >= 0) glUniformMatrix4fv(viewLoc, 1, GL_FALSE, &view[0][0]);
-            if (projLoc >= 0) glUniformMatrix4fv(projLoc, 1, GL_FALSE, &orthoProjection[0][0]);
-            
-            // Bind texture
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, charTexture);
-            GLint texLoc = glGetUniformLocation(cardShaderProgram, "cardTexture");
-            if (texLoc >= 0) glUniform1i(texLoc, 0);
-            
-            // Draw character
-            if (VAO != 0) {
-                glBindVertexArray(VAO);
-                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-                glBindVertexArray(0);
+            if (c != ' ') {
+                pushSprite(textShaderProgram, basicFont.texture, basicFont.rectFor(c), renderX + charWidth/2, renderY + charHeight/2,
+                           charWidth, charHeight, color);
             }
-            
-            // Cleanup
-            glDeleteTextures(1, &charTexture);
-            
             renderX += spacing;
         }
     }
-    
-    glEnable(GL_DEPTH_TEST); // Re-enable depth testing
 }
 
 void Renderer::renderEnhancedText(const std::string& text, float x, float y, float scale) {
     // Enhanced text rendering with better contrast and readability
-    glDisable(GL_DEPTH_TEST);
+    bool useSdf = sdfFontAtlas != 0;
+    if (!useSdf && hudFont.texture == 0) return;
     
     // Scale font size based on viewport dimensions for better readability
     float baseSize = std::min(viewportWidth, viewportHeight) / 40.0f;
@@ -654,53 +1629,19 @@ void Renderer::renderEnhancedText(const std::string& text, float x, float y, flo
     float panelWidth = text.length() * spacing + 0.02f;
     float panelHeight = charHeight + 0.02f;
     
-    // Render background panel
-    glUseProgram(cardShaderProgram);
-    
-    // Create dark semi-transparent background
-    const int PANEL_SIZE = 4;
-    unsigned char panelData[PANEL_SIZE * PANEL_SIZE * 4];
-    for (int i = 0; i < PANEL_SIZE * PANEL_SIZE * 4; i += 4) {
-        panelData[i] = 0;     // R
-        panelData[i+1] = 0;   // G
-        panelData[i+2] = 0;   // B
-        panelData[i+3] = 128; // A (semi-transparent)
-    }
-    
-    GLuint panelTexture;
-    glGenTextures(1, &panelTexture);
-    glBindTexture(GL_TEXTURE_2D, panelTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PANEL_SIZE, PANEL_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, panelData);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    
-    // Render background panel
-    glm::mat4 orthoProjection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
-    glm::mat4 panelModel = glm::mat4(1.0f);
-    panelModel = glm::translate(panelModel, glm::vec3(x + panelWidth/2 - 0.01f, y + panelHeight/2 - 0.01f, 0.05f));
-    panelModel = glm::scale(panelModel, glm::vec3(panelWidth, panelHeight, 1.0f));
-    
-    GLint modelLoc = glGetUniformLocation(cardShaderProgram, "model");
-    GLint viewLoc = glGetUniformLocation(cardShaderProgram, "view");
-    GLint projLoc = glGetUniformLocation(cardShaderProgram, "projection");
-    
-    if (modelLoc >= 0) glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &panelModel[0][0]);
-    if (viewLoc >= 0) glUniformMatrix4fv(viewLoc, 1, GL_FALSE, &view[0][0]);
-    if (projLoc >= 0) glUniformMatrix4fv(projLoc, 1, GL_FALSE, &orthoProjection[0][0]);
-    
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, panelTexture);
-    GLint texLoc = glGetUniformLocation(cardShaderProgram, "cardTexture");
-    if (texLoc >= 0) glUniform1i(texLoc, 0);
-    
-    if (VAO != 0) {
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+    // Dark semi-transparent background from the atlas's solid texels; drawn by the
+    // same program and texture as the glyphs, so panels and text share one batch
+    glm::vec4 panelColor(0.0f, 0.0f, 0.0f, 128.0f / 255.0f);
+    float panelX = x + panelWidth/2 - 0.01f;
+    float panelY = y + panelHeight/2 - 0.01f;
+    if (useSdf) {
+        const FontGlyph& solid = sdfFont.getSolid();
+        pushSprite(sdfShaderProgram, sdfFontAtlas, glm::vec4(solid.u0, solid.v0, solid.u1, solid.v1),
+                   panelX, panelY, panelWidth, panelHeight, panelColor);
+        queueSdfText(text, x, y, charWidth, charHeight, spacing, glm::vec4(1.0f));
+        return;
     }
-    
-    glDeleteTextures(1, &panelTexture);
+    pushSprite(textShaderProgram, hudFont.texture, hudFont.solidRect, panelX, panelY, panelWidth, panelHeight, panelColor);
     
     // Now render text with outline for better visibility
     float shadowOffsets[] = {-0.002f, 0.002f, 0.0f};
@@ -711,499 +1652,18 @@ void Renderer::renderEnhancedText(const std::string& text, float x, float y, flo
         float renderY = y + shadowOffsets[pass];
         bool isMainText = !isShadowPass[pass];
         
+        // Bright white text over black outlines
+        glm::vec4 color = isMainText ? glm::vec4(1.0f) : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        
         for (size_t i = 0; i < text.length(); i++) {
             char c = text[i];
-            if (c == ' ') {
-                renderX += spacing;
-                continue;
-            }
-            
-            const int CHAR_SIZE = 16; // Even larger for better quality
-            unsigned char charBitmap[CHAR_SIZE * CHAR_SIZE * 4];
-            
-            // Fill with transparent background
-            for (int j = 0; j < CHAR_SIZE * CHAR_SIZE * 4; j += 4) {
-                if (isMainText) {
-                    charBitmap[j] = 255;     // R - Bright white text
-                    charBitmap[j+1] = 255;   // G  
-                    charBitmap[j+2] = 255;   // B
-                } else {
-                    charBitmap[j] = 0;       // R - Black outline
-                    charBitmap[j+1] = 0;     // G
-                    charBitmap[j+2] = 0;     // B
-                }
-                charBitmap[j+3] = 0;         // A (transparent)
+            if (c != ' ') {
+                pushSprite(textShaderProgram, hudFont.texture, hudFont.rectFor(c), renderX + charWidth/2, renderY + charHeight/2,
+                           charWidth, charHeight, color);
             }
-            
-            // Enhanced character patterns with complete alphabet support
-            switch (c) {
-                case '0': case 'O': case 'o':
-                    for (int row = 3; row < 13; row++) {
-                        for (int col = 3; col < 13; col++) {
-                            if ((row == 3 || row == 12) && (col > 4 && col < 11)) {
-                                charBitmap[(row * CHAR_SIZE + col) * 4 + 3] = 255;
-                            } else if ((col == 3 || col == 12) && (row > 4 && row < 11)) {
-                                charBitmap[(row * CHAR_SIZE + col) * 4 + 3] = 255;
-                            } else if ((row == 4 || row == 11) && (col == 4 || col == 11)) {
-                                charBitmap[(row * CHAR_SIZE + col) * 4 + 3] = 255;
-                            }
-                        }
-                    }
-                    break;
-                case '1': case 'I': case 'i':
-                    for (int row = 2; row < 14; row++) {
-                        charBitmap[(row * CHAR_SIZE + 7) * 4 + 3] = 255;
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    }
-                    for (int col = 5; col < 11; col++) {
-                        charBitmap[(2 * CHAR_SIZE + col) * 4 + 3] = 255;
-                        charBitmap[(13 * CHAR_SIZE + col) * 4 + 3] = 255;
-                    }
-                    break;
-                case '2':
-                    for (int col = 3; col < 12; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 8; row++) {
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right top
-                    }
-                    for (int row = 9; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left bottom
-                    }
-                    break;
-                case '3':
-                    for (int col = 3; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 12; row++) {
-                        if (row != 8) charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    break;
-                case '4':
-                    for (int row = 3; row < 9; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int col = 3; col < 12; col++) {
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                    }
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    break;
-                case '5': case 'S': case 's':
-                    for (int col = 3; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 8; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left top
-                    }
-                    for (int row = 9; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right bottom
-                    }
-                    break;
-                case '6':
-                    for (int col = 3; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int row = 9; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right bottom
-                    }
-                    break;
-                case '7':
-                    for (int col = 3; col < 12; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                    }
-                    for (int row = 4; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    break;
-                case '8':
-                    for (int col = 3; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 12; row++) {
-                        if (row != 8) {
-                            charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                            charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                        }
-                    }
-                    break;
-                case '9':
-                    for (int col = 3; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 8; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left top
-                    }
-                    for (int row = 4; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    break;
-                case 'A': case 'a':
-                    for (int col = 4; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                    }
-                    for (int row = 4; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    break;
-                case 'B': case 'b':
-                    for (int col = 3; col < 10; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int row = 4; row < 8; row++) {
-                        charBitmap[(row * CHAR_SIZE + 10) * 4 + 3] = 255; // right top
-                    }
-                    for (int row = 9; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 10) * 4 + 3] = 255; // right bottom
-                    }
-                    break;
-                case 'C': case 'c':
-                    for (int col = 4; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    break;
-                case 'D': case 'd':
-                    for (int col = 3; col < 10; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int row = 4; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 10) * 4 + 3] = 255; // right
-                    }
-                    charBitmap[(4 * CHAR_SIZE + 11) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 11) * 4 + 3] = 255;
-                    break;
-                case 'E': case 'e':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int col = 3; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    break;
-                case 'F': case 'f':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int col = 3; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                    }
-                    break;
-                case 'G': case 'g':
-                    for (int col = 4; col < 11; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int row = 8; row < 12; row++) {
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right bottom
-                    }
-                    for (int col = 8; col < 11; col++) {
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle bar
-                    }
-                    break;
-                case 'H': case 'h':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    for (int col = 3; col < 12; col++) {
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                    }
-                    break;
-                case 'J': case 'j':
-                    for (int row = 3; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    for (int col = 4; col < 11; col++) {
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    charBitmap[(11 * CHAR_SIZE + 3) * 4 + 3] = 255;
-                    break;
-                case 'K': case 'k':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    // Diagonal lines
-                    charBitmap[(5 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(6 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(7 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(8 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(4 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(3 * CHAR_SIZE + 9) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 9) * 4 + 3] = 255;
-                    charBitmap[(12 * CHAR_SIZE + 10) * 4 + 3] = 255;
-                    break;
-                case 'L': case 'l':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int col = 3; col < 11; col++) {
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    break;
-                case 'M': case 'm':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255;  // left
-                        charBitmap[(row * CHAR_SIZE + 12) * 4 + 3] = 255; // right
-                    }
-                    // Middle peaks
-                    charBitmap[(4 * CHAR_SIZE + 4) * 4 + 3] = 255;
-                    charBitmap[(4 * CHAR_SIZE + 10) * 4 + 3] = 255;
-                    charBitmap[(5 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(5 * CHAR_SIZE + 9) * 4 + 3] = 255;
-                    charBitmap[(6 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(6 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(7 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    break;
-                case 'N': case 'n':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                        // Diagonal
-                        int diagCol = 3 + (row - 3);
-                        if (diagCol <= 11) {
-                            charBitmap[(row * CHAR_SIZE + diagCol) * 4 + 3] = 255;
-                        }
-                    }
-                    break;
-                case 'P': case 'p':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int col = 3; col < 10; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                    }
-                    for (int row = 4; row < 8; row++) {
-                        charBitmap[(row * CHAR_SIZE + 10) * 4 + 3] = 255; // right top
-                    }
-                    break;
-                case 'Q': case 'q':
-                    for (int col = 4; col < 10; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(11 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    for (int row = 4; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                        charBitmap[(row * CHAR_SIZE + 10) * 4 + 3] = 255; // right
-                    }
-                    // Tail
-                    charBitmap[(10 * CHAR_SIZE + 9) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 10) * 4 + 3] = 255;
-                    charBitmap[(12 * CHAR_SIZE + 11) * 4 + 3] = 255;
-                    break;
-                case 'R': case 'r':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                    }
-                    for (int col = 3; col < 10; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(8 * CHAR_SIZE + col) * 4 + 3] = 255;  // middle
-                    }
-                    for (int row = 4; row < 8; row++) {
-                        charBitmap[(row * CHAR_SIZE + 10) * 4 + 3] = 255; // right top
-                    }
-                    // Diagonal leg
-                    charBitmap[(9 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(12 * CHAR_SIZE + 9) * 4 + 3] = 255;
-                    break;
-                case 'T': case 't':
-                    for (int col = 2; col < 13; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                    }
-                    for (int row = 4; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 7) * 4 + 3] = 255;  // center
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    }
-                    break;
-                case 'U': case 'u':
-                    for (int row = 3; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    for (int col = 4; col < 11; col++) {
-                        charBitmap[(11 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255;
-                    }
-                    break;
-                case 'V': case 'v':
-                    for (int row = 3; row < 9; row++) {
-                        charBitmap[(row * CHAR_SIZE + 3) * 4 + 3] = 255;  // left
-                        charBitmap[(row * CHAR_SIZE + 11) * 4 + 3] = 255; // right
-                    }
-                    charBitmap[(9 * CHAR_SIZE + 4) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 10) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 9) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(12 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    break;
-                case 'W': case 'w':
-                    for (int row = 3; row < 11; row++) {
-                        charBitmap[(row * CHAR_SIZE + 2) * 4 + 3] = 255;  // left
-                        charBitmap[(row * CHAR_SIZE + 12) * 4 + 3] = 255; // right
-                    }
-                    charBitmap[(9 * CHAR_SIZE + 7) * 4 + 3] = 255;  // center peak
-                    charBitmap[(10 * CHAR_SIZE + 4) * 4 + 3] = 255; // left support
-                    charBitmap[(10 * CHAR_SIZE + 10) * 4 + 3] = 255; // right support
-                    charBitmap[(11 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 9) * 4 + 3] = 255;
-                    charBitmap[(12 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    break;
-                case 'X': case 'x':
-                    // Draw X pattern
-                    for (int i = 0; i < 10; i++) {
-                        charBitmap[((3 + i) * CHAR_SIZE + (3 + i)) * 4 + 3] = 255; // main diagonal
-                        charBitmap[((3 + i) * CHAR_SIZE + (12 - i)) * 4 + 3] = 255; // anti-diagonal
-                    }
-                    break;
-                case 'Y': case 'y':
-                    charBitmap[(3 * CHAR_SIZE + 3) * 4 + 3] = 255;  // top left
-                    charBitmap[(3 * CHAR_SIZE + 11) * 4 + 3] = 255; // top right
-                    charBitmap[(4 * CHAR_SIZE + 4) * 4 + 3] = 255;  // converging
-                    charBitmap[(4 * CHAR_SIZE + 10) * 4 + 3] = 255;
-                    charBitmap[(5 * CHAR_SIZE + 5) * 4 + 3] = 255;
-                    charBitmap[(5 * CHAR_SIZE + 9) * 4 + 3] = 255;
-                    charBitmap[(6 * CHAR_SIZE + 6) * 4 + 3] = 255;
-                    charBitmap[(6 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    for (int row = 7; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 7) * 4 + 3] = 255; // center vertical
-                    }
-                    break;
-                case 'Z': case 'z':
-                    for (int col = 3; col < 12; col++) {
-                        charBitmap[(3 * CHAR_SIZE + col) * 4 + 3] = 255;  // top
-                        charBitmap[(12 * CHAR_SIZE + col) * 4 + 3] = 255; // bottom
-                    }
-                    // Diagonal
-                    for (int i = 0; i < 9; i++) {
-                        charBitmap[((4 + i) * CHAR_SIZE + (11 - i)) * 4 + 3] = 255;
-                    }
-                    break;
-                case ':':
-                    charBitmap[(5 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(5 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(6 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(6 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(9 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(10 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    break;
-                case '!':
-                    for (int row = 3; row < 10; row++) {
-                        charBitmap[(row * CHAR_SIZE + 7) * 4 + 3] = 255;
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    }
-                    charBitmap[(11 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(11 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    charBitmap[(12 * CHAR_SIZE + 7) * 4 + 3] = 255;
-                    charBitmap[(12 * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    break;
-                case '|':
-                    for (int row = 3; row < 13; row++) {
-                        charBitmap[(row * CHAR_SIZE + 7) * 4 + 3] = 255;
-                        charBitmap[(row * CHAR_SIZE + 8) * 4 + 3] = 255;
-                    }
-                    break;
-                default:
-                    // Improved block for unknown characters
-                    for (int row = 5; row < 11; row++) {
-                        for (int col = 4; col < 12; col++) {
-                            if (row == 5 || row == 10 || col == 4 || col == 11) {
-                                charBitmap[(row * CHAR_SIZE + col) * 4 + 3] = 255;
-                            }
-                        }
-                    }
-                    break;
-            }
-            
-            // Flip the bitmap vertically to fix mirroring issue in enhanced text
-            unsigned char flippedBitmap[CHAR_SIZE * CHAR_SIZE * 4];
-            for (int row = 0; row < CHAR_SIZE; row++) {
-                for (int col = 0; col < CHAR_SIZE; col++) {
-                    int srcIndex = (row * CHAR_SIZE + col) * 4;
-                    int dstIndex = ((CHAR_SIZE - 1 - row) * CHAR_SIZE + col) * 4;
-                    flippedBitmap[dstIndex + 0] = charBitmap[srcIndex + 0];
-                    flippedBitmap[dstIndex + 1] = charBitmap[srcIndex + 1];
-                    flippedBitmap[dstIndex + 2] = charBitmap[srcIndex + 2];
-                    flippedBitmap[dstIndex + 3] = charBitmap[srcIndex + 3];
-                }
-            }
-            
-            // Create and render character texture
-            GLuint charTexture;
-            glGenTextures(1, &charTexture);
-            glBindTexture(GL_TEXTURE_2D, charTexture);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, CHAR_SIZE, CHAR_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, flippedBitmap);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, glm::vec3(renderX + charWidth/2, renderY + charHeight/2, 0.1f));
-            model = glm::scale(model, glm::vec3(charWidth, charHeight, 1.0f));
-            
-            if (modelLoc >= 0) glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
-            
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, charTexture);
-            if (texLoc >= 0) glUniform1i(texLoc, 0);
-            
-            if (VAO != 0) {
-                glBindVertexArray(VAO);
-                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-                glBindVertexArray(0);
-            }
-            
-            glDeleteTextures(1, &charTexture);
             renderX += spacing;
         }
     }
-    
-    glEnable(GL_DEPTH_TEST);
 }
 
 void Renderer::setProjectionMatrix(int width, int height) {
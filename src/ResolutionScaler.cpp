@@ -0,0 +1,56 @@
+#include "ResolutionScaler.h"
+#include <algorithm>
+#include <cmath>
+
+ResolutionScaler::ResolutionScaler()
+    : budget(0.0f), scale(1.0f), total(0.0f), count(0), settling(false), lastAverage(0.0f), changes(0) {
+}
+
+void ResolutionScaler::setBudget(float milliseconds) {
+    budget = std::max(milliseconds, 0.0f);
+    if (budget == 0.0f && scale != 1.0f) {
+        scale = 1.0f;
+        changes++;
+    }
+    total = 0.0f;
+    count = 0;
+}
+
+bool ResolutionScaler::addFrame(float milliseconds) {
+    if (budget <= 0.0f) {
+        return false;
+    }
+    if (settling) {
+        settling = false;
+        return false;
+    }
+    total += milliseconds;
+    count++;
+    if (count < WINDOW) {
+        return false;
+    }
+    float average = total / count;
+    lastAverage = average;
+    total = 0.0f;
+    count = 0;
+
+    float next = scale;
+    if (average > budget) {
+        // Cost follows the pixel count, so the side shrinks with its square root
+        float fit = scale * std::sqrt(budget * HEADROOM / average);
+        next = std::min(std::floor(fit / STEP) * STEP, scale - STEP);
+    } else if (scale < 1.0f) {
+        float larger = scale + STEP;
+        if (average * (larger * larger) / (scale * scale) < budget * HEADROOM) {
+            next = larger;
+        }
+    }
+    next = std::max(MIN_SCALE, std::min(next, 1.0f));
+    if (next == scale) {
+        return false;
+    }
+    scale = next;
+    settling = true;
+    changes++;
+    return true;
+}
@@ -0,0 +1,126 @@
+#include "SdfFont.h"
+#include "TrueTypeFont.h"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+namespace {
+
+const int FIRST_CHAR = 32;  // Space
+const int LAST_CHAR = 126;  // Tilde
+const int SOLID_SIZE = 4;   // Solid block; panels sample its center
+
+struct BakedGlyph {
+    std::vector<unsigned char> bitmap; // Empty for the solid block and blank glyphs
+    int width = 0;
+    int height = 0;
+    int xOffset = 0;
+    int yOffset = 0;
+    float advance = 0;
+    bool missing = false; // The font has no glyph for this character
+    int x = 0; // Position in the atlas
+    int y = 0;
+};
+
+} // namespace
+
+SdfFont::SdfFont() : atlasWidth(0), atlasHeight(0), ascent(0), descent(0) {
+}
+
+bool SdfFont::load(const std::string& path) {
+    atlas.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open font: " << path << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> ttf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    TrueTypeFont font;
+    if (!font.open(ttf.data(), ttf.size())) {
+        std::cerr << "Not a TrueType font: " << path << std::endl;
+        return false;
+    }
+
+    float scale = font.scaleForPixelHeight(static_cast<float>(PIXEL_HEIGHT));
+    int fontAscent, fontDescent, lineGap;
+    font.getVMetrics(fontAscent, fontDescent, lineGap);
+    ascent = fontAscent * scale;
+    descent = fontDescent * scale;
+
+    // Render every glyph's distance field, then shelf-pack them left to right
+    std::vector<BakedGlyph> baked(LAST_CHAR - FIRST_CHAR + 2); // Last entry is the solid block
+    for (int c = FIRST_CHAR; c <= LAST_CHAR; c++) {
+        BakedGlyph& glyph = baked[c - FIRST_CHAR];
+        int index = font.findGlyphIndex(c);
+        glyph.missing = index == 0;
+        int advance, leftSideBearing;
+        font.getGlyphHMetrics(index, advance, leftSideBearing);
+        glyph.advance = advance * scale;
+        glyph.bitmap = font.getGlyphSdf(index, scale, PADDING, ONEDGE_VALUE, PIXEL_DIST_SCALE,
+                                        glyph.width, glyph.height, glyph.xOffset, glyph.yOffset);
+    }
+    baked.back().width = SOLID_SIZE;
+    baked.back().height = SOLID_SIZE;
+
+    int penX = 0, penY = 0, shelfHeight = 0;
+    for (BakedGlyph& glyph : baked) {
+        if (penX + glyph.width > ATLAS_WIDTH) {
+            penX = 0;
+            penY += shelfHeight + 1;
+            shelfHeight = 0;
+        }
+        glyph.x = penX;
+        glyph.y = penY;
+        penX += glyph.width + 1; // One texel apart so filtering never mixes glyphs
+        shelfHeight = std::max(shelfHeight, glyph.height);
+    }
+    atlasWidth = ATLAS_WIDTH;
+    atlasHeight = penY + shelfHeight;
+
+    atlas.assign(static_cast<size_t>(atlasWidth) * atlasHeight, 0);
+    for (const BakedGlyph& glyph : baked) {
+        for (int row = 0; row < glyph.height; row++) {
+            unsigned char* dst = &atlas[static_cast<size_t>(glyph.y + row) * atlasWidth + glyph.x];
+            if (!glyph.bitmap.empty()) {
+                std::copy(glyph.bitmap.begin() + row * glyph.width, glyph.bitmap.begin() + (row + 1) * glyph.width, dst);
+            } else {
+                std::fill(dst, dst + glyph.width, static_cast<unsigned char>(255)); // Solid block
+            }
+        }
+    }
+
+    auto describe = [this](const BakedGlyph& glyph) {
+        FontGlyph result;
+        result.u0 = static_cast<float>(glyph.x) / atlasWidth;
+        result.v0 = static_cast<float>(glyph.y) / atlasHeight;
+        result.u1 = static_cast<float>(glyph.x + glyph.width) / atlasWidth;
+        result.v1 = static_cast<float>(glyph.y + glyph.height) / atlasHeight;
+        result.width = glyph.width;
+        result.height = glyph.height;
+        result.xOffset = glyph.xOffset;
+        result.yOffset = glyph.yOffset;
+        result.advance = glyph.advance;
+        return result;
+    };
+
+    FontGlyph fallback = describe(baked['?' - FIRST_CHAR]);
+    for (int c = 0; c < 128; c++) {
+        bool available = c >= FIRST_CHAR && c <= LAST_CHAR && !baked[c - FIRST_CHAR].missing;
+        glyphs[c] = available ? describe(baked[c - FIRST_CHAR]) : fallback;
+    }
+
+    // Panels sample the middle of the solid block
+    const BakedGlyph& block = baked.back();
+    solid = describe(block);
+    solid.u0 = solid.u1 = (block.x + SOLID_SIZE * 0.5f) / atlasWidth;
+    solid.v0 = solid.v1 = (block.y + SOLID_SIZE * 0.5f) / atlasHeight;
+    return true;
+}
+
+const FontGlyph& SdfFont::getGlyph(char c) const {
+    unsigned char code = static_cast<unsigned char>(c);
+    return glyphs[code < 128 ? code : '?'];
+}
@@ -0,0 +1,143 @@
+#include "StreamBuffer.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+StreamBuffer::StreamBuffer() : buffer(0), persistent(false), mapped(nullptr), segmentSize(0), segment(0), cursor(0),
+                               fences(), generation(0), stalls(0) {
+}
+
+StreamBuffer::~StreamBuffer() {
+    release();
+}
+
+bool StreamBuffer::create(size_t bytesPerSegment, bool allowPersistent) {
+    release();
+    persistent = allowPersistent && (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage);
+    return allocate(bytesPerSegment);
+}
+
+bool StreamBuffer::allocate(size_t bytesPerSegment) {
+    // Any earlier buffer stays alive in the driver until the draws using it are done
+    if (buffer != 0) {
+        glDeleteBuffers(1, &buffer); // Also unmaps it
+        buffer = 0;
+        mapped = nullptr;
+    }
+    releaseFences();
+    
+    size_t totalSize = bytesPerSegment * SEGMENTS;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (persistent) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags));
+        if (mapped == nullptr) {
+            std::cerr << "Persistent buffer mapping failed, streaming by orphaning" << std::endl;
+            glDeleteBuffers(1, &buffer); // Immutable storage cannot be respecified
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            persistent = false;
+        }
+    }
+    if (!persistent) {
+        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    
+    segmentSize = bytesPerSegment;
+    segment = 0;
+    cursor = 0;
+    generation++;
+    return true;
+}
+
+void StreamBuffer::release() {
+    releaseFences();
+    if (buffer != 0) {
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    mapped = nullptr;
+    segmentSize = 0;
+    segment = 0;
+    cursor = 0;
+}
+
+void StreamBuffer::releaseFences() {
+    for (GLsync& fence : fences) {
+        if (fence != nullptr) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+}
+
+GLintptr StreamBuffer::write(const void* data, size_t bytes, size_t alignment) {
+    if (buffer == 0 || bytes == 0) {
+        return -1;
+    }
+    alignment = std::max<size_t>(alignment, 1);
+    size_t offset = (cursor + alignment - 1) / alignment * alignment;
+    
+    if (persistent) {
+        // A frame that outgrows its segment gets a fresh, larger buffer for the rest of it
+        size_t segmentEnd = (segment + 1) * segmentSize;
+        if (offset + bytes > segmentEnd) {
+            size_t grown = std::max(segmentSize * 2, bytes + alignment);
+            std::cout << "Stream buffer segment grown to " << grown / 1024.0f << " KB" << std::endl;
+            allocate(grown);
+            offset = 0;
+        }
+        std::memcpy(mapped + offset, data, bytes);
+        cursor = offset + bytes;
+        return static_cast<GLintptr>(offset);
+    }
+    
+    // Orphaning: a write past the end starts a fresh store (bigger, if it could never fit)
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (offset + bytes > segmentSize * SEGMENTS) {
+        if (bytes + alignment > segmentSize * SEGMENTS) {
+            segmentSize = (bytes + alignment) / SEGMENTS + 1;
+        }
+        glBufferData(GL_COPY_WRITE_BUFFER, segmentSize * SEGMENTS, nullptr, GL_STREAM_DRAW);
+        offset = 0;
+    }
+    void* target = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, bytes,
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (target != nullptr) {
+        std::memcpy(target, data, bytes);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    } else {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, bytes, data);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    cursor = offset + bytes;
+    return static_cast<GLintptr>(offset);
+}
+
+void StreamBuffer::endFrame() {
+    if (!persistent || buffer == 0) {
+        return; // Orphaning needs no fences: the driver tracks the old stores
+    }
+    fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    segment = (segment + 1) % SEGMENTS;
+    cursor = segment * segmentSize;
+    
+    // The next segment was last written SEGMENTS - 1 frames ago; normally its fence has
+    // long signaled, and waiting only happens when the GPU is that far behind
+    GLsync& fence = fences[segment];
+    if (fence == nullptr) {
+        return;
+    }
+    GLenum state = glClientWaitSync(fence, 0, 0);
+    if (state == GL_TIMEOUT_EXPIRED) {
+        stalls++;
+        do {
+            state = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000); // 100 ms
+        } while (state == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
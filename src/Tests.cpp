@@ -1,9 +1,32 @@
 // Simple runtime tests for deck generation invariants.
 #include "Deck.h"
 #include "GameManager.h"
+#include "WorkerPool.h"
+#include "CardRasterizer.h"
+#include "CardTextureCache.h"
+#include "BitmapFont.h"
+#include "SdfFont.h"
+#include "TrueTypeFont.h"
+#include "GpuProfiler.h"
+#include "ProgramBinaryCache.h"
+#include "TripleBuffer.h"
+#include "BoardWall.h"
+#include "FrameRecorder.h"
+#include "ResolutionScaler.h"
+#include "InputManager.h"
+#include "AssetLoader.h"
+#include "BoardView.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <set>
 #include <map>
+#include <atomic>
+#include <thread>
 
 static bool testDeckFrequencies(int pairs) {
     Deck d; d.createPairs(pairs);
@@ -19,10 +42,409 @@ static bool testDeckFrequencies(int pairs) {
     return true;
 }
 
+static bool testWorkerPoolRunsEveryTask() {
+    WorkerPool pool(4);
+    std::atomic<int> counter(0);
+    std::vector<std::future<void>> done;
+    for (int i = 0; i < 64; i++) {
+        done.push_back(pool.submit([&counter]() { counter++; }));
+    }
+    for (auto &f : done) f.get();
+    if (counter != 64) { std::cerr << "FAIL: expected 64 tasks run got=" << counter << "\n"; return false; }
+    return true;
+}
+
+static bool testRasterizerMatchesReference() {
+    // Every rank/suit combination covers all 16 pattern kernels and all corner styles
+    for (int suit = 0; suit < 4; suit++) {
+        for (int rank = 1; rank <= 13; rank++) {
+            std::vector<unsigned char> reference = Card::createDetailedCardPixels(rank, suit, true);
+            std::vector<unsigned char> fast = CardRasterizer::rasterize(rank, suit, true);
+            if (reference != fast) {
+                std::cerr << "FAIL: " << CardRasterizer::getInstructionSet() << " rasterizer differs for rank="
+                          << rank << " suit=" << suit << "\n";
+                return false;
+            }
+        }
+    }
+    return CardRasterizer::rasterize(0, 0, false) == Card::createDetailedCardPixels(0, 0, false);
+}
+
+static bool testFaceFinishedBeforeShown() {
+    // Clicking starts background generation; the first frame that shows the front mid-flip
+    // must have the view finish that face before drawing
+    GameManager game;
+    game.initialize(4);
+    glm::vec2 position = game.getDeck().getCards()[0]->getPosition();
+    if (!game.handleMouseClick(position.x, position.y)) { std::cerr << "FAIL: click did not flip\n"; return false; }
+    
+    FrameSnapshot frame;
+    game.publish(frame);
+    auto cardIn = [&](const std::vector<CardInstance>& instances) -> const CardInstance* {
+        for (const CardInstance& instance : instances) {
+            if (instance.x == position.x && instance.y == position.y) return &instance;
+        }
+        return nullptr;
+    };
+    const CardInstance* instance = cardIn(frame.animated);
+    if (instance == nullptr || instance->showFront) { std::cerr << "FAIL: flip did not start face down\n"; return false; }
+    
+    for (int tick = 0; tick < 100; tick++) {
+        game.update(0.016f);
+        game.publish(frame);
+        const CardInstance* flipping = cardIn(frame.animated);
+        const CardInstance* shown = flipping ? flipping : cardIn(frame.resting);
+        if (shown == nullptr || !shown->showFront) continue;
+        if (flipping == nullptr) { std::cerr << "FAIL: front first shown after the flip\n"; return false; }
+        std::vector<int> finished = BoardView::getShownFaces(frame.resting, frame.animated);
+        bool requested = std::find(frame.requestedFaces.begin(), frame.requestedFaces.end(), shown->layer) != frame.requestedFaces.end();
+        if (!requested || std::find(finished.begin(), finished.end(), shown->layer) == finished.end()) {
+            std::cerr << "FAIL: face layer " << shown->layer << " not prefetched and finished before it shows\n"; return false;
+        }
+        return true;
+    }
+    std::cerr << "FAIL: front never shown\n";
+    return false;
+}
+
+static bool testPalettizeIsLossless() {
+    // Every face and the back must fit in one palette and reconstruct exactly
+    std::vector<unsigned char> indices(Card::TEXTURE_SIZE * Card::TEXTURE_SIZE);
+    std::vector<unsigned char> palette(CardRasterizer::PALETTE_SIZE * 4);
+    for (int layer = 0; layer < CardTextureCache::LAYER_COUNT; layer++) {
+        int suit = (layer - 1) / 13, rank = (layer - 1) % 13 + 1;
+        std::vector<unsigned char> rgba = layer == 0 ? Card::createDetailedCardPixels(0, 0, false)
+                                                     : Card::createDetailedCardPixels(rank, suit, true);
+        int colors = CardRasterizer::palettize(rgba.data(), indices.data(), palette.data());
+        if (colors > CardRasterizer::PALETTE_SIZE) { std::cerr << "FAIL: palette overflow\n"; return false; }
+        for (size_t i = 0; i < indices.size(); i++) {
+            if (std::memcmp(&palette[indices[i] * 4], &rgba[i * 4], 4) != 0) {
+                std::cerr << "FAIL: palettized layer " << layer << " differs at texel " << i << "\n"; return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool testTextureCacheRoundTrip() {
+    const char* path = "test_card_textures.cache";
+    WorkerPool pool(2);
+    if (!CardTextureCache::build(path, pool)) { std::cerr << "FAIL: could not write cache\n"; return false; }
+    
+    bool ok = true;
+    const size_t layerBytes = (size_t)Card::TEXTURE_SIZE * Card::TEXTURE_SIZE * 4;
+    {
+        CardTextureCache cache;
+        if (!cache.open(path)) { std::cerr << "FAIL: could not map fresh cache\n"; std::remove(path); return false; }
+        std::vector<unsigned char> back = Card::createDetailedCardPixels(0, 0, false);
+        std::vector<unsigned char> front = Card::createDetailedCardPixels(7, 2, true);
+        if (std::memcmp(cache.getBack(), back.data(), layerBytes) != 0 ||
+            std::memcmp(cache.getFront(7, 2), front.data(), layerBytes) != 0) {
+            std::cerr << "FAIL: cached pixels differ from the generator\n"; ok = false;
+        }
+    }
+    
+    // A cache from another generator version must be rejected
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(8);
+        uint32_t staleVersion = Card::TEXTURE_VERSION + 1;
+        file.write(reinterpret_cast<const char*>(&staleVersion), sizeof(staleVersion));
+    }
+    CardTextureCache stale;
+    if (stale.open(path)) { std::cerr << "FAIL: stale cache version accepted\n"; ok = false; }
+    stale.close();
+    std::remove(path);
+    return ok;
+}
+
+static bool testHudGlyphsAreDistinct() {
+    // Every character the HUD prints must have its own glyph, not the unknown-character block
+    const char* hudChars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789:!+-*./";
+    const int size = BitmapFont::HUD_SIZE;
+    auto cell = [&](int code) {
+        std::vector<unsigned char> pixels;
+        for (int row = 0; row < size; row++) {
+            const unsigned char* line = &BitmapFont::HUD.coverage[(BitmapFont::cellOriginY(size, code) + row) * BitmapFont::atlasWidth(size) +
+                                                                  BitmapFont::cellOriginX(size, code)];
+            pixels.insert(pixels.end(), line, line + size);
+        }
+        return pixels;
+    };
+    std::vector<unsigned char> unknown = cell('\x01');
+    for (const char* c = hudChars; *c; c++) {
+        if (cell(*c) == unknown) { std::cerr << "FAIL: no HUD glyph for '" << *c << "'\n"; return false; }
+    }
+    return true;
+}
+
+static bool testSdfFontBakesGlyphs() {
+    // The bundled TrueType font bakes every printable glyph with an inside and an outside
+    SdfFont font;
+    if (!font.load("assets/fonts/SourceCodePro-Bold.ttf")) { std::cerr << "FAIL: font did not load\n"; return false; }
+    for (char c = '!'; c <= '~'; c++) {
+        const FontGlyph& glyph = font.getGlyph(c);
+        if (glyph.width <= 2 * SdfFont::PADDING || glyph.height <= 2 * SdfFont::PADDING) {
+            std::cerr << "FAIL: glyph '" << c << "' has no outline\n"; return false;
+        }
+        int x0 = static_cast<int>(glyph.u0 * font.getAtlasWidth() + 0.5f);
+        int y0 = static_cast<int>(glyph.v0 * font.getAtlasHeight() + 0.5f);
+        int inside = 0, outside = 0;
+        for (int y = 0; y < glyph.height; y++) {
+            for (int x = 0; x < glyph.width; x++) {
+                unsigned char d = font.getAtlas()[(y0 + y) * font.getAtlasWidth() + x0 + x];
+                if (d > SdfFont::ONEDGE_VALUE) inside++; else outside++;
+            }
+        }
+        if (inside == 0 || outside == 0) { std::cerr << "FAIL: glyph '" << c << "' field is flat\n"; return false; }
+    }
+    if (font.getGlyph(' ').width != 0) { std::cerr << "FAIL: space has a bitmap\n"; return false; }
+    if (font.getGlyph('\x80').u0 != font.getGlyph('?').u0) { std::cerr << "FAIL: no fallback glyph\n"; return false; }
+    return true;
+}
+
+static bool testTrueTypeFontRejectsTruncatedFile() {
+    // Tables that run past the end of the file must fail to open rather than be read
+    std::ifstream file("assets/fonts/SourceCodePro-Bold.ttf", std::ios::binary);
+    std::vector<unsigned char> ttf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    TrueTypeFont font;
+    if (!font.open(ttf.data(), ttf.size())) { std::cerr << "FAIL: font did not open\n"; return false; }
+    for (size_t length : {size_t(0), size_t(11), size_t(64), ttf.size() / 2}) {
+        std::vector<unsigned char> truncated(ttf.begin(), ttf.begin() + length);
+        if (font.open(truncated.data(), truncated.size())) { std::cerr << "FAIL: opened a font truncated to " << length << " bytes\n"; return false; }
+    }
+    
+    // A zero line height (descent == ascent in hhea) would make every scale infinite
+    std::vector<unsigned char> flat(ttf);
+    for (size_t record = 12; record + 16 <= 12 + 16 * size_t(flat[4] << 8 | flat[5]); record += 16) {
+        if (std::memcmp(&flat[record], "hhea", 4) == 0) {
+            size_t hhea = size_t(flat[record + 8]) << 24 | size_t(flat[record + 9]) << 16 | size_t(flat[record + 10]) << 8 | flat[record + 11];
+            flat[hhea + 6] = flat[hhea + 4];
+            flat[hhea + 7] = flat[hhea + 5];
+        }
+    }
+    if (font.open(flat.data(), flat.size())) { std::cerr << "FAIL: opened a font with no line height\n"; return false; }
+    
+    // Scales that are not finite, or boxes too large to allocate, give no bitmap
+    if (!font.open(ttf.data(), ttf.size())) { std::cerr << "FAIL: font did not reopen\n"; return false; }
+    int glyph = font.findGlyphIndex('W'), width, height, xOffset, yOffset;
+    for (float scale : {std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(), 1e6f}) {
+        if (!font.getGlyphSdf(glyph, scale, 4, 128, 32.0f, width, height, xOffset, yOffset).empty() || width != 0) {
+            std::cerr << "FAIL: SDF rendered at scale " << scale << "\n"; return false;
+        }
+    }
+    return true;
+}
+
+static bool testProgramCacheRoundTrip() {
+    const char* path = "test_program_binaries.cache";
+    const uint64_t driver = ProgramBinaryCache::hash("vendor renderer version");
+    ProgramBinaryCache::Binary binary;
+    binary.format = 0x8741;
+    binary.data = {1, 2, 3, 250, 0, 7};
+    {
+        ProgramBinaryCache cache;
+        cache.load(path, driver); // Missing file: empty cache for this driver
+        cache.store(42, binary);
+        if (!cache.isDirty() || !cache.save(path)) { std::cerr << "FAIL: could not write cache\n"; std::remove(path); return false; }
+    }
+    
+    bool ok = true;
+    ProgramBinaryCache cache;
+    const ProgramBinaryCache::Binary* loaded = cache.load(path, driver) ? cache.find(42) : nullptr;
+    if (loaded == nullptr || loaded->format != binary.format || loaded->data != binary.data || cache.find(43) != nullptr) {
+        std::cerr << "FAIL: cached binary differs\n"; ok = false;
+    }
+    
+    // Binaries from another driver must never be offered
+    ProgramBinaryCache other;
+    if (other.load(path, driver + 1) || other.size() != 0) { std::cerr << "FAIL: other driver's cache accepted\n"; ok = false; }
+    std::remove(path);
+    return ok;
+}
+
+static bool testGpuStatsRollOver() {
+    // The window keeps only the newest HISTORY samples for the average and maximum
+    GpuProfiler::RollingStats stats;
+    if (stats.getAverage() != 0.0f || stats.getMax() != 0.0f) { std::cerr << "FAIL: empty stats not zero\n"; return false; }
+    stats.add(10.0f);
+    for (int i = 0; i < GpuProfiler::HISTORY; i++) stats.add(1.0f);
+    if (stats.getCount() != GpuProfiler::HISTORY) { std::cerr << "FAIL: count " << stats.getCount() << "\n"; return false; }
+    if (stats.getMax() != 1.0f || stats.getAverage() != 1.0f) { std::cerr << "FAIL: old sample still counted\n"; return false; }
+    stats.add(3.0f);
+    if (stats.getLast() != 3.0f || stats.getMax() != 3.0f) { std::cerr << "FAIL: newest sample missing\n"; return false; }
+    return true;
+}
+
+static bool testSnapshotsHandOffNewest() {
+    // One thread: only the newest published value is read, and only once
+    TripleBuffer<int> buffer;
+    if (buffer.acquire()) { std::cerr << "FAIL: nothing published yet\n"; return false; }
+    buffer.writeBuffer() = 1; buffer.publish();
+    buffer.writeBuffer() = 2; buffer.publish();
+    if (!buffer.acquire() || buffer.readBuffer() != 2) { std::cerr << "FAIL: newest value not read\n"; return false; }
+    if (buffer.acquire() || buffer.readBuffer() != 2) { std::cerr << "FAIL: value read twice\n"; return false; }
+    
+    // Two threads: every snapshot read is whole and ticks never go backwards
+    TripleBuffer<std::vector<unsigned long long>> snapshots;
+    const unsigned long long TICKS = 20000;
+    std::thread producer([&] {
+        for (unsigned long long tick = 1; tick <= TICKS; tick++) {
+            snapshots.writeBuffer().assign(16, tick);
+            snapshots.publish();
+        }
+    });
+    unsigned long long last = 0;
+    bool ok = true;
+    while (last < TICKS && ok) {
+        if (!snapshots.acquire()) continue;
+        const std::vector<unsigned long long>& snapshot = snapshots.readBuffer();
+        for (unsigned long long tick : snapshot) {
+            if (tick != snapshot.front()) ok = false;
+        }
+        if (snapshot.front() <= last) ok = false;
+        last = snapshot.front();
+    }
+    producer.join();
+    if (!ok) { std::cerr << "FAIL: torn or stale snapshot after tick " << last << "\n"; return false; }
+    
+    // The simulation publishes every card and no GL state
+    GameManager game;
+    game.initialize(4);
+    game.update(0.01f);
+    FrameSnapshot frame;
+    game.publish(frame);
+    if (frame.tick != 1 || frame.faces.size() != 8 || frame.resting.size() != 8 || !frame.animated.empty()) {
+        std::cerr << "FAIL: snapshot does not hold the board\n"; return false;
+    }
+    return true;
+}
+
+static bool testWallRoutesClicksToBoards() {
+    // Every tile maps back to its board, and a click flips a card of that board only
+    BoardWall wall;
+    wall.initialize(6, 4, 1024, 768);
+    if (wall.getColumns() * wall.getRows() < 6) { std::cerr << "FAIL: grid too small\n"; return false; }
+    glm::mat4 projection = wall.getProjection(1024, 768);
+    for (int board = 0; board < wall.getBoardCount(); board++) {
+        glm::vec2 origin = wall.getBoardOrigin(board);
+        if (wall.boardAt(origin.x, origin.y) != board) { std::cerr << "FAIL: tile " << board << " maps elsewhere\n"; return false; }
+        glm::vec4 ndc = projection * glm::vec4(origin, 0.0f, 1.0f);
+        glm::vec2 screen((ndc.x + 1.0f) * 0.5f * 1024, (1.0f - ndc.y) * 0.5f * 768);
+        glm::vec2 back = wall.screenToWall(screen, 1024, 768);
+        if (glm::distance(back, origin) > 0.5f) { std::cerr << "FAIL: screen mapping of board " << board << "\n"; return false; }
+    }
+    
+    glm::vec2 card = wall.getBoard(3).getDeck().getCards()[0]->getPosition() + wall.getBoardOrigin(3);
+    if (!wall.handleMouseClick(card.x, card.y)) { std::cerr << "FAIL: click did not flip\n"; return false; }
+    for (int board = 0; board < wall.getBoardCount(); board++) {
+        if ((wall.getBoard(board).getMoves() > 0 || wall.getBoard(board).isAnimating()) != (board == 3)) {
+            std::cerr << "FAIL: board " << board << " saw the click\n"; return false;
+        }
+    }
+    return true;
+}
+
+static bool testI420Conversion() {
+    // 2x2 RGBA, bottom row first as GL reads it: black at the bottom, white on top
+    const unsigned char rgba[16] = {0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255};
+    std::vector<unsigned char> planes;
+    FrameRecorder::convertToI420(rgba, 2, 2, planes);
+    if (planes.size() != 6) { std::cerr << "FAIL: plane size " << planes.size() << "\n"; return false; }
+    if (planes[0] != 235 || planes[1] != 235 || planes[2] != 16 || planes[3] != 16) {
+        std::cerr << "FAIL: luma not studio range or rows not flipped\n"; return false;
+    }
+    if (planes[4] != 128 || planes[5] != 128) { std::cerr << "FAIL: grey has chroma\n"; return false; }
+    
+    // Saturated red: Cr high, Cb low; odd sizes round the chroma planes up
+    std::vector<unsigned char> red(3 * 3 * 4, 0);
+    for (size_t i = 0; i < red.size(); i += 4) { red[i] = 255; red[i + 3] = 255; }
+    FrameRecorder::convertToI420(red.data(), 3, 3, planes);
+    if (planes.size() != 9 + 2 * 4) { std::cerr << "FAIL: odd plane size " << planes.size() << "\n"; return false; }
+    if (planes[0] != 82 || planes[9] != 90 || planes[13] != 240) {
+        std::cerr << "FAIL: red converts to " << int(planes[0]) << " " << int(planes[9]) << " " << int(planes[13]) << "\n"; return false;
+    }
+    return true;
+}
+
+static bool testResolutionScalerHoldsBudget() {
+    // A frame costs 20 ms at full size and scales with the pixel count
+    ResolutionScaler scaler;
+    scaler.setBudget(10.0f);
+    for (int frame = 0; frame < 20 * ResolutionScaler::WINDOW; frame++) {
+        float scale = scaler.getScale();
+        scaler.addFrame(20.0f * scale * scale);
+    }
+    float scale = scaler.getScale();
+    if (scale != 0.625f || scaler.getChanges() != 1) {
+        std::cerr << "FAIL: settled at " << scale << " after " << scaler.getChanges() << " changes\n"; return false;
+    }
+    
+    // Never below the minimum; no budget is full size again
+    scaler.setBudget(1.0f);
+    for (int frame = 0; frame < 10 * ResolutionScaler::WINDOW; frame++) {
+        scaler.addFrame(20.0f);
+    }
+    if (scaler.getScale() != ResolutionScaler::MIN_SCALE) { std::cerr << "FAIL: scale below minimum\n"; return false; }
+    scaler.setBudget(0.0f);
+    if (scaler.getScale() != 1.0f || scaler.addFrame(100.0f)) { std::cerr << "FAIL: disabled scaler still scales\n"; return false; }
+    return true;
+}
+
+static bool testScreenToWorldMatchesProjection() {
+    // Window corners and center land where the projection puts them, at any window size
+    const int sizes[2][2] = {{1024, 768}, {1600, 600}};
+    for (const auto& size : sizes) {
+        float halfWidth = 400.0f * size[0] / size[1];
+        glm::mat4 projection = glm::ortho(-halfWidth, halfWidth, -400.0f, 400.0f, -100.0f, 100.0f);
+        glm::vec2 topLeft = InputManager::screenToWorld(glm::vec2(0.0f, 0.0f), projection, size[0], size[1]);
+        glm::vec2 center = InputManager::screenToWorld(glm::vec2(size[0] / 2.0f, size[1] / 2.0f), projection, size[0], size[1]);
+        glm::vec2 bottomRight = InputManager::screenToWorld(glm::vec2(size[0], size[1]), projection, size[0], size[1]);
+        if (glm::distance(topLeft, glm::vec2(-halfWidth, 400.0f)) > 0.01f || glm::distance(center, glm::vec2(0.0f)) > 0.01f ||
+            glm::distance(bottomRight, glm::vec2(halfWidth, -400.0f)) > 0.01f) {
+            std::cerr << "FAIL: screen mapping at " << size[0] << "x" << size[1] << "\n"; return false;
+        }
+    }
+    return true;
+}
+
+static bool testAssetLoaderWithoutThread() {
+    // No shared context: every job uploads and completes inside submit, in order
+    AssetLoader loader;
+    std::vector<int> order;
+    AssetLoader::Ticket first = loader.submit([&] { order.push_back(1); }, [&] { order.push_back(2); });
+    AssetLoader::Ticket second = loader.submit([&] { order.push_back(3); }, nullptr);
+    if (loader.isThreaded() || first == 0 || second <= first) { std::cerr << "FAIL: tickets\n"; return false; }
+    if (order != std::vector<int>{1, 2, 3} || loader.getPending() != 0) { std::cerr << "FAIL: jobs not run in order\n"; return false; }
+    
+    // Nothing to wait for; no fences were made
+    loader.wait(second);
+    loader.finish();
+    loader.poll();
+    if (loader.getUploads() != 0 || loader.getBlockingWaits() != 0) { std::cerr << "FAIL: immediate jobs were fenced\n"; return false; }
+    return true;
+}
+
 int runAllTests() {
     int failures = 0;
     if (!testDeckFrequencies(8)) { std::cerr << "testDeckFrequencies(8) failed\n"; failures++; }
     if (!testDeckFrequencies(4)) { std::cerr << "testDeckFrequencies(4) failed\n"; failures++; }
+    if (!testWorkerPoolRunsEveryTask()) { std::cerr << "testWorkerPoolRunsEveryTask failed\n"; failures++; }
+    if (!testRasterizerMatchesReference()) { std::cerr << "testRasterizerMatchesReference failed\n"; failures++; }
+    if (!testFaceFinishedBeforeShown()) { std::cerr << "testFaceFinishedBeforeShown failed\n"; failures++; }
+    if (!testPalettizeIsLossless()) { std::cerr << "testPalettizeIsLossless failed\n"; failures++; }
+    if (!testTextureCacheRoundTrip()) { std::cerr << "testTextureCacheRoundTrip failed\n"; failures++; }
+    if (!testHudGlyphsAreDistinct()) { std::cerr << "testHudGlyphsAreDistinct failed\n"; failures++; }
+    if (!testSdfFontBakesGlyphs()) { std::cerr << "testSdfFontBakesGlyphs failed\n"; failures++; }
+    if (!testTrueTypeFontRejectsTruncatedFile()) { std::cerr << "testTrueTypeFontRejectsTruncatedFile failed\n"; failures++; }
+    if (!testProgramCacheRoundTrip()) { std::cerr << "testProgramCacheRoundTrip failed\n"; failures++; }
+    if (!testGpuStatsRollOver()) { std::cerr << "testGpuStatsRollOver failed\n"; failures++; }
+    if (!testSnapshotsHandOffNewest()) { std::cerr << "testSnapshotsHandOffNewest failed\n"; failures++; }
+    if (!testWallRoutesClicksToBoards()) { std::cerr << "testWallRoutesClicksToBoards failed\n"; failures++; }
+    if (!testI420Conversion()) { std::cerr << "testI420Conversion failed\n"; failures++; }
+    if (!testResolutionScalerHoldsBudget()) { std::cerr << "testResolutionScalerHoldsBudget failed\n"; failures++; }
+    if (!testScreenToWorldMatchesProjection()) { std::cerr << "testScreenToWorldMatchesProjection failed\n"; failures++; }
+    if (!testAssetLoaderWithoutThread()) { std::cerr << "testAssetLoaderWithoutThread failed\n"; failures++; }
     if (failures==0) std::cout << "All deck tests passed.\n";
     return failures;
 }
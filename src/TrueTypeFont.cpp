@@ -0,0 +1,516 @@
+#include "TrueTypeFont.h"
+#include <cmath>
+
+namespace {
+
+// Big-endian readers; callers have checked the bytes lie inside the file
+uint16_t readU16(const unsigned char* p) { return static_cast<uint16_t>(p[0] << 8 | p[1]); }
+int16_t readS16(const unsigned char* p) { return static_cast<int16_t>(readU16(p)); }
+uint32_t readU32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 | static_cast<uint32_t>(p[2]) << 8 | p[3];
+}
+
+bool hasTag(const unsigned char* p, const char* tag) {
+    return p[0] == static_cast<unsigned char>(tag[0]) && p[1] == static_cast<unsigned char>(tag[1]) &&
+           p[2] == static_cast<unsigned char>(tag[2]) && p[3] == static_cast<unsigned char>(tag[3]);
+}
+
+// True if [offset, offset + length) lies within size bytes
+bool fits(uint64_t size, uint64_t offset, uint64_t length) {
+    return offset <= size && length <= size - offset;
+}
+
+bool isFont(const unsigned char* p) {
+    // TrueType 1, TrueType with type 1 font, or Apple 'true'
+    static const char version1[4] = {0, 1, 0, 0};
+    static const char versionOne[4] = {'1', 0, 0, 0};
+    return hasTag(p, version1) || hasTag(p, versionOne) || hasTag(p, "typ1") || hasTag(p, "true");
+}
+
+// Reads one glyph's bytes; reading past its end yields zeros and clears ok
+struct GlyphReader {
+    const unsigned char* p;
+    const unsigned char* end;
+    bool ok = true;
+
+    bool take(size_t n) {
+        if (static_cast<size_t>(end - p) < n) {
+            ok = false;
+            p = end;
+            return false;
+        }
+        return true;
+    }
+    uint8_t u8() { return take(1) ? *p++ : 0; }
+    int8_t s8() { return static_cast<int8_t>(u8()); }
+    uint16_t u16() {
+        if (!take(2)) return 0;
+        uint16_t value = readU16(p);
+        p += 2;
+        return value;
+    }
+    int16_t s16() { return static_cast<int16_t>(u16()); }
+    void skip(size_t n) {
+        if (take(n)) p += n;
+    }
+};
+
+void addVertex(std::vector<TrueTypeFont::Vertex>& out, TrueTypeFont::VertexType type, int32_t x, int32_t y,
+               int32_t cx, int32_t cy) {
+    out.push_back({static_cast<int16_t>(x), static_cast<int16_t>(y), static_cast<int16_t>(cx), static_cast<int16_t>(cy), type});
+}
+
+// Convert one contour of on/off-curve points to move/line/curve commands.
+// Consecutive off-curve points imply an on-curve point halfway between them.
+void emitContour(std::vector<TrueTypeFont::Vertex>& out, const int32_t* xs, const int32_t* ys, const uint8_t* on, int n) {
+    if (n <= 0) return;
+
+    int32_t sx, sy;
+    int first, last; // Points still to visit after the start point, in order
+    if (on[0]) {
+        sx = xs[0]; sy = ys[0];
+        first = 1; last = n - 1;
+    } else if (on[n - 1]) {
+        sx = xs[n - 1]; sy = ys[n - 1];
+        first = 0; last = n - 2;
+    } else {
+        sx = (xs[0] + xs[n - 1]) >> 1; sy = (ys[0] + ys[n - 1]) >> 1;
+        first = 0; last = n - 1;
+    }
+    addVertex(out, TrueTypeFont::MOVE, sx, sy, 0, 0);
+
+    bool wasOff = false;
+    int32_t cx = 0, cy = 0;
+    for (int i = first; i <= last; ++i) {
+        if (!on[i]) {
+            if (wasOff) {
+                addVertex(out, TrueTypeFont::CURVE, (cx + xs[i]) >> 1, (cy + ys[i]) >> 1, cx, cy);
+            }
+            cx = xs[i]; cy = ys[i];
+            wasOff = true;
+        } else {
+            if (wasOff) {
+                addVertex(out, TrueTypeFont::CURVE, xs[i], ys[i], cx, cy);
+            } else {
+                addVertex(out, TrueTypeFont::LINE, xs[i], ys[i], 0, 0);
+            }
+            wasOff = false;
+        }
+    }
+    // Close back to the start point
+    if (wasOff) {
+        addVertex(out, TrueTypeFont::CURVE, sx, sy, cx, cy);
+    } else {
+        addVertex(out, TrueTypeFont::LINE, sx, sy, 0, 0);
+    }
+}
+
+// Squared distance from (px, py) to the segment (x0, y0)-(x1, y1)
+float segmentDistance2(float px, float py, float x0, float y0, float x1, float y1) {
+    float dx = x1 - x0, dy = y1 - y0;
+    float len2 = dx * dx + dy * dy;
+    float t = len2 > 0 ? ((px - x0) * dx + (py - y0) * dy) / len2 : 0;
+    if (t < 0) t = 0;
+    if (t > 1) t = 1;
+    float ex = x0 + t * dx - px, ey = y0 + t * dy - py;
+    return ex * ex + ey * ey;
+}
+
+} // namespace
+
+TrueTypeFont::TrueTypeFont() : data(nullptr), size(0), numGlyphs(0), numLongHorMetrics(0), indexToLocFormat(0) {
+}
+
+bool TrueTypeFont::findTable(uint32_t fontStart, const char* tag, Table& table) const {
+    uint16_t numTables = readU16(data + fontStart + 4);
+    uint64_t directory = static_cast<uint64_t>(fontStart) + 12;
+    if (!fits(size, directory, 16ull * numTables)) return false;
+    for (uint32_t i = 0; i < numTables; ++i) {
+        const unsigned char* record = data + directory + 16 * i;
+        if (hasTag(record, tag)) {
+            table.offset = readU32(record + 8);
+            table.length = readU32(record + 12);
+            return fits(size, table.offset, table.length);
+        }
+    }
+    return false;
+}
+
+bool TrueTypeFont::open(const unsigned char* fontData, size_t fontSize, int fontIndex) {
+    *this = TrueTypeFont();
+    data = fontData;
+    size = fontSize;
+    if (data == nullptr || size < 12 || fontIndex < 0) return false;
+
+    // A single font has only index 0; a collection has a 'ttcf' header, version 1
+    // or 2, then an offset per font
+    uint32_t fontStart = 0;
+    if (hasTag(data, "ttcf")) {
+        uint32_t version = readU32(data + 4);
+        if (version != 0x00010000 && version != 0x00020000) return false;
+        uint32_t count = readU32(data + 8);
+        if (static_cast<uint32_t>(fontIndex) >= count || !fits(size, 12 + 4ull * fontIndex, 4)) return false;
+        fontStart = readU32(data + 12 + 4 * fontIndex);
+    } else if (fontIndex != 0) {
+        return false;
+    }
+    if (!fits(size, fontStart, 12) || !isFont(data + fontStart)) return false;
+
+    Table cmap, maxp;
+    if (!findTable(fontStart, "cmap", cmap) || !findTable(fontStart, "head", head) ||
+        !findTable(fontStart, "hhea", hhea) || !findTable(fontStart, "hmtx", hmtx) ||
+        !findTable(fontStart, "maxp", maxp)) {
+        return false;
+    }
+    if (!findTable(fontStart, "glyf", glyf) || !findTable(fontStart, "loca", loca)) return false; // CFF outlines are not supported
+    if (head.length < 54 || hhea.length < 36 || maxp.length < 6 || cmap.length < 4) return false;
+    if (readS16(data + hhea.offset + 4) - readS16(data + hhea.offset + 6) <= 0) return false; // No line height to scale by
+
+    indexToLocFormat = readU16(data + head.offset + 50);
+    if (indexToLocFormat > 1) return false;
+    numLongHorMetrics = readU16(data + hhea.offset + 34);
+    if (numLongHorMetrics == 0 || hmtx.length < 4u * numLongHorMetrics) return false;
+
+    // loca holds one more entry than there are glyphs
+    uint32_t locaEntries = loca.length / (indexToLocFormat == 0 ? 2 : 4);
+    if (locaEntries == 0) return false;
+    numGlyphs = readU16(data + maxp.offset + 4);
+    if (static_cast<uint32_t>(numGlyphs) > locaEntries - 1) numGlyphs = static_cast<int>(locaEntries - 1);
+
+    // Prefer a Unicode encoding: Microsoft Unicode BMP/full, then the Unicode platform
+    const unsigned char* cmapData = data + cmap.offset;
+    uint16_t numEncodings = readU16(cmapData + 2);
+    if (!fits(cmap.length, 4, 8ull * numEncodings)) return false;
+    for (uint16_t i = 0; i < numEncodings; ++i) {
+        const unsigned char* record = cmapData + 4 + 8 * i;
+        uint16_t platform = readU16(record);
+        uint16_t encoding = readU16(record + 2);
+        uint32_t subtable = readU32(record + 4);
+        if (((platform == 3 && (encoding == 1 || encoding == 10)) || platform == 0) && fits(cmap.length, subtable, 2)) {
+            indexMap.offset = cmap.offset + subtable;
+            indexMap.length = cmap.length - subtable;
+        }
+    }
+    return indexMap.length != 0;
+}
+
+int TrueTypeFont::findGlyphIndex(int codepoint) const {
+    if (indexMap.length == 0 || codepoint < 0) return 0;
+    const unsigned char* map = data + indexMap.offset;
+    auto has = [this](uint64_t offset, uint64_t length) { return fits(indexMap.length, offset, length); };
+    uint32_t cp = static_cast<uint32_t>(codepoint);
+
+    uint16_t format = readU16(map);
+    if (format == 0) { // Apple byte encoding
+        if (!has(0, 6)) return 0;
+        uint32_t bytes = readU16(map + 2);
+        if (cp + 6 < bytes && has(6 + cp, 1)) return map[6 + cp];
+        return 0;
+    } else if (format == 6) { // Trimmed table
+        if (!has(0, 10)) return 0;
+        uint32_t firstCode = readU16(map + 6);
+        uint32_t count = readU16(map + 8);
+        if (cp >= firstCode && cp < firstCode + count && has(10 + 2ull * (cp - firstCode), 2)) {
+            return readU16(map + 10 + 2 * (cp - firstCode));
+        }
+        return 0;
+    } else if (format == 4) { // Segment mapping to delta values (the usual BMP table)
+        if (cp > 0xffff || !has(0, 14)) return 0;
+        uint32_t segCount = readU16(map + 6) >> 1;
+        // endCode, a reserved pad, startCode, idDelta and idRangeOffset arrays
+        const uint32_t endCodes = 14;
+        if (!has(endCodes, 8ull * segCount + 2)) return 0;
+        for (uint32_t seg = 0; seg < segCount; ++seg) {
+            uint16_t end = readU16(map + endCodes + 2 * seg);
+            if (cp > end) continue;
+            uint16_t start = readU16(map + endCodes + 2 * segCount + 2 + 2 * seg);
+            if (cp < start) return 0;
+            uint32_t deltaLoc = endCodes + 4 * segCount + 2 + 2 * seg;
+            uint32_t rangeLoc = endCodes + 6 * segCount + 2 + 2 * seg;
+            uint16_t offset = readU16(map + rangeLoc);
+            if (offset == 0) {
+                return static_cast<uint16_t>(cp + readS16(map + deltaLoc));
+            }
+            uint64_t glyphLoc = static_cast<uint64_t>(rangeLoc) + offset + 2 * (cp - start);
+            if (!has(glyphLoc, 2)) return 0;
+            uint16_t glyph = readU16(map + glyphLoc);
+            return glyph == 0 ? 0 : static_cast<uint16_t>(glyph + readS16(map + deltaLoc));
+        }
+        return 0;
+    } else if (format == 12 || format == 13) { // Segmented coverage / many-to-one
+        if (!has(0, 16)) return 0;
+        uint32_t groups = readU32(map + 12);
+        if (!has(16, 12ull * groups)) return 0;
+        uint32_t low = 0, high = groups;
+        while (low < high) {
+            uint32_t mid = low + ((high - low) >> 1);
+            const unsigned char* group = map + 16 + 12 * mid;
+            uint32_t startChar = readU32(group);
+            uint32_t endChar = readU32(group + 4);
+            if (cp < startChar) {
+                high = mid;
+            } else if (cp > endChar) {
+                low = mid + 1;
+            } else {
+                uint32_t startGlyph = readU32(group + 8);
+                return static_cast<int>(format == 12 ? startGlyph + cp - startChar : startGlyph);
+            }
+        }
+        return 0;
+    }
+    return 0;
+}
+
+void TrueTypeFont::getVMetrics(int& ascent, int& descent, int& lineGap) const {
+    ascent = readS16(data + hhea.offset + 4);
+    descent = readS16(data + hhea.offset + 6);
+    lineGap = readS16(data + hhea.offset + 8);
+}
+
+float TrueTypeFont::scaleForPixelHeight(float height) const {
+    int fheight = readS16(data + hhea.offset + 4) - readS16(data + hhea.offset + 6);
+    return height / static_cast<float>(fheight);
+}
+
+void TrueTypeFont::getGlyphHMetrics(int glyph, int& advanceWidth, int& leftSideBearing) const {
+    const unsigned char* metrics = data + hmtx.offset;
+    if (glyph < 0) glyph = 0;
+    if (glyph < numLongHorMetrics) {
+        advanceWidth = readS16(metrics + 4 * glyph);
+        leftSideBearing = readS16(metrics + 4 * glyph + 2);
+    } else {
+        // Monospaced tail: the last advance repeats, bearings follow the long metrics
+        advanceWidth = readS16(metrics + 4 * (numLongHorMetrics - 1));
+        uint64_t bearing = 4ull * numLongHorMetrics + 2ull * (glyph - numLongHorMetrics);
+        leftSideBearing = fits(hmtx.length, bearing, 2) ? readS16(metrics + bearing) : 0;
+    }
+}
+
+bool TrueTypeFont::getGlyphRange(int glyph, uint32_t& start, uint32_t& end) const {
+    if (glyph < 0 || glyph >= numGlyphs) return false;
+
+    // open() checked loca holds numGlyphs + 1 entries
+    const unsigned char* offsets = data + loca.offset;
+    if (indexToLocFormat == 0) {
+        start = readU16(offsets + glyph * 2) * 2u;
+        end = readU16(offsets + glyph * 2 + 2) * 2u;
+    } else {
+        start = readU32(offsets + glyph * 4);
+        end = readU32(offsets + glyph * 4 + 4);
+    }
+    // Zero length means an empty glyph; anything else needs at least the 10-byte header
+    if (start >= end || end > glyf.length || end - start < 10) return false;
+    start += glyf.offset;
+    end += glyf.offset;
+    return true;
+}
+
+bool TrueTypeFont::getGlyphBox(int glyph, int& x0, int& y0, int& x1, int& y1) const {
+    uint32_t start, end;
+    if (!getGlyphRange(glyph, start, end)) return false;
+    x0 = readS16(data + start + 2);
+    y0 = readS16(data + start + 4);
+    x1 = readS16(data + start + 6);
+    y1 = readS16(data + start + 8);
+    return true;
+}
+
+std::vector<TrueTypeFont::Vertex> TrueTypeFont::getGlyphShape(int glyph) const {
+    return getGlyphShape(glyph, 0);
+}
+
+std::vector<TrueTypeFont::Vertex> TrueTypeFont::getGlyphShape(int glyph, int depth) const {
+    std::vector<Vertex> vertices;
+    uint32_t start, end;
+    if (!getGlyphRange(glyph, start, end)) return vertices;
+
+    GlyphReader in{data + start, data + end};
+    int16_t numberOfContours = in.s16();
+    in.skip(8); // Bounding box
+
+    if (numberOfContours > 0) {
+        // Simple glyph: contour end points, instructions, then packed flags and coordinates
+        std::vector<uint16_t> endPoints(numberOfContours);
+        for (int c = 0; c < numberOfContours; ++c) {
+            endPoints[c] = in.u16();
+            if (c > 0 && endPoints[c] <= endPoints[c - 1]) return vertices;
+        }
+        in.skip(in.u16()); // Instructions
+        if (!in.ok) return vertices;
+        int n = endPoints.back() + 1;
+
+        std::vector<uint8_t> flags(n);
+        uint8_t flag = 0, flagCount = 0;
+        for (int i = 0; i < n; ++i) {
+            if (flagCount == 0) {
+                flag = in.u8();
+                if (flag & 8) flagCount = in.u8();
+            } else {
+                --flagCount;
+            }
+            flags[i] = flag;
+        }
+
+        std::vector<int32_t> xs(n), ys(n);
+        int32_t x = 0;
+        for (int i = 0; i < n; ++i) {
+            flag = flags[i];
+            if (flag & 2) {
+                int16_t dx = in.u8();
+                x += (flag & 16) ? dx : -dx;
+            } else if (!(flag & 16)) {
+                x += in.s16();
+            }
+            xs[i] = x;
+        }
+
+        int32_t y = 0;
+        for (int i = 0; i < n; ++i) {
+            flag = flags[i];
+            if (flag & 4) {
+                int16_t dy = in.u8();
+                y += (flag & 32) ? dy : -dy;
+            } else if (!(flag & 32)) {
+                y += in.s16();
+            }
+            ys[i] = y;
+        }
+        if (!in.ok) return vertices;
+
+        for (int i = 0; i < n; ++i) flags[i] &= 1; // Keep only the on-curve bit
+
+        // Each point yields at most one command, plus a move and a close per contour
+        vertices.reserve(n + numberOfContours * 2);
+        int first = 0;
+        for (int c = 0; c < numberOfContours; ++c) {
+            emitContour(vertices, &xs[first], &ys[first], &flags[first], endPoints[c] - first + 1);
+            first = endPoints[c] + 1;
+        }
+        return vertices;
+    }
+
+    if (numberOfContours < 0) {
+        // Composite glyph: components with an offset and an optional 2x2 transform
+        if (depth > 8) return vertices;
+        bool more = true;
+        while (more) {
+            uint16_t flags = in.u16();
+            uint16_t component = in.u16();
+            float mtx[6] = {1, 0, 0, 1, 0, 0};
+
+            if (flags & 2) { // XY values
+                if (flags & 1) { // Shorts
+                    mtx[4] = in.s16();
+                    mtx[5] = in.s16();
+                } else {
+                    mtx[4] = in.s8();
+                    mtx[5] = in.s8();
+                }
+            } else {
+                in.skip((flags & 1) ? 4 : 2); // Point matching is not supported
+            }
+            if (flags & (1 << 3)) { // WE_HAVE_A_SCALE
+                mtx[0] = mtx[3] = in.s16() / 16384.0f;
+            } else if (flags & (1 << 6)) { // WE_HAVE_AN_X_AND_Y_SCALE
+                mtx[0] = in.s16() / 16384.0f;
+                mtx[3] = in.s16() / 16384.0f;
+            } else if (flags & (1 << 7)) { // WE_HAVE_A_TWO_BY_TWO
+                mtx[0] = in.s16() / 16384.0f;
+                mtx[1] = in.s16() / 16384.0f;
+                mtx[2] = in.s16() / 16384.0f;
+                mtx[3] = in.s16() / 16384.0f;
+            }
+            if (!in.ok) return {};
+
+            for (Vertex v : getGlyphShape(component, depth + 1)) {
+                int16_t vx = v.x, vy = v.y;
+                v.x = static_cast<int16_t>(mtx[0] * vx + mtx[2] * vy + mtx[4]);
+                v.y = static_cast<int16_t>(mtx[1] * vx + mtx[3] * vy + mtx[5]);
+                vx = v.cx; vy = v.cy;
+                v.cx = static_cast<int16_t>(mtx[0] * vx + mtx[2] * vy + mtx[4]);
+                v.cy = static_cast<int16_t>(mtx[1] * vx + mtx[3] * vy + mtx[5]);
+                vertices.push_back(v);
+            }
+            more = flags & (1 << 5); // MORE_COMPONENTS
+        }
+    }
+    return vertices; // Empty glyph when numberOfContours is 0
+}
+
+std::vector<unsigned char> TrueTypeFont::getGlyphSdf(int glyph, float scale, int padding, unsigned char onedgeValue,
+                                                     float pixelDistScale, int& width, int& height, int& xOffset,
+                                                     int& yOffset) const {
+    std::vector<unsigned char> bitmap;
+    width = height = xOffset = yOffset = 0;
+    int x0, y0, x1, y1;
+    if (!(scale > 0) || !std::isfinite(scale) || padding < 0) return bitmap;
+    if (!getGlyphBox(glyph, x0, y0, x1, y1)) return bitmap;
+    if (x0 >= x1 || y0 >= y1) return bitmap; // Blank, or a corrupt box
+
+    // Pixel box with y down, grown by the padding on every side; checked in floating
+    // point so an absurd box is refused before it is converted to int
+    float left = std::floor(x0 * scale), top = std::floor(-y1 * scale);
+    float right = std::ceil(x1 * scale), bottom = std::ceil(-y0 * scale);
+    if (right - left + 2.0f * padding > MAX_SDF_SIZE || bottom - top + 2.0f * padding > MAX_SDF_SIZE) {
+        return bitmap;
+    }
+    int ix0 = static_cast<int>(left) - padding;
+    int iy0 = static_cast<int>(top) - padding;
+    int ix1 = static_cast<int>(right) + padding;
+    int iy1 = static_cast<int>(bottom) + padding;
+    int w = ix1 - ix0;
+    int h = iy1 - iy0;
+
+    // Flatten the outline into line segments in pixel space (y down)
+    const int CURVE_STEPS = 8;
+    std::vector<float> segments;
+    float cx = 0, cy = 0;
+    for (const Vertex& v : getGlyphShape(glyph)) {
+        float vx = v.x * scale, vy = -v.y * scale;
+        if (v.type == LINE) {
+            segments.insert(segments.end(), {cx, cy, vx, vy});
+        } else if (v.type == CURVE) {
+            float qx = v.cx * scale, qy = -v.cy * scale;
+            float px = cx, py = cy;
+            for (int step = 1; step <= CURVE_STEPS; ++step) {
+                float t = static_cast<float>(step) / CURVE_STEPS, it = 1 - t;
+                float nx = it * it * cx + 2 * it * t * qx + t * t * vx;
+                float ny = it * it * cy + 2 * it * t * qy + t * t * vy;
+                segments.insert(segments.end(), {px, py, nx, ny});
+                px = nx; py = ny;
+            }
+        }
+        cx = vx; cy = vy;
+    }
+
+    bitmap.resize(static_cast<size_t>(w) * h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            float sx = ix0 + x + 0.5f;
+            float sy = iy0 + y + 0.5f;
+            float minDist2 = 1e30f;
+            int winding = 0;
+            for (size_t i = 0; i < segments.size(); i += 4) {
+                const float* s = &segments[i];
+                float d2 = segmentDistance2(sx, sy, s[0], s[1], s[2], s[3]);
+                if (d2 < minDist2) minDist2 = d2;
+                // Nonzero winding along a horizontal ray to +x
+                if ((s[1] > sy) != (s[3] > sy)) {
+                    float ix = s[0] + (sy - s[1]) * (s[2] - s[0]) / (s[3] - s[1]);
+                    if (ix > sx) winding += s[3] > s[1] ? 1 : -1;
+                }
+            }
+            float dist = std::sqrt(minDist2);
+            float value = onedgeValue + pixelDistScale * (winding != 0 ? dist : -dist);
+            if (value < 0) value = 0;
+            if (value > 255) value = 255;
+            bitmap[static_cast<size_t>(y) * w + x] = static_cast<unsigned char>(value + 0.5f > 255 ? 255 : value + 0.5f);
+        }
+    }
+
+    width = w;
+    height = h;
+    xOffset = ix0;
+    yOffset = iy0;
+    return bitmap;
+}
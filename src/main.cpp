@@ -4,12 +4,28 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 #include <chrono>
+#include <thread>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
 
 #include "GameManager.h"
 #include "Renderer.h"
 #include "InputManager.h"
+#include "HeadlessContext.h"
+#include "TripleBuffer.h"
+#include "FrameSnapshot.h"
+#include "BoardView.h"
+#include "BoardWall.h"
+#include "FrameRecorder.h"
 
-// Window dimensions
+// Initial window dimensions (the window can be resized)
 const int WINDOW_WIDTH = 1024;
 const int WINDOW_HEIGHT = 768;
 const char* WINDOW_TITLE = "Memory Card Matching Game";
@@ -17,10 +33,79 @@ const char* WINDOW_TITLE = "Memory Card Matching Game";
 // Game settings
 const int NUM_PAIRS = 8; // 16 cards total
 
+// Frame pacing: animations run at targetFps (with vsync and/or a sleep limiter);
+// when nothing moves the loop sleeps in glfwWaitEventsTimeout until input arrives
+// or the HUD clock needs its next second drawn
+struct FramePacing {
+    int targetFps = 60; // 0 = uncapped (vsync only, if enabled)
+    bool vsync = true;
+    bool idleWait = true; // false renders continuously, as before
+    
+    // Latency: cap the frames the driver may queue (0 = driver default) and
+    // optionally flip cards on mouse press instead of release
+    int maxFramesInFlight = 0;
+    bool flipOnPress = false;
+};
+
+// Headless mode: render a scripted game offscreen (no window, no input)
+struct HeadlessOptions {
+    bool enabled = false;
+    int frames = 600;
+    int width = WINDOW_WIDTH;
+    int height = WINDOW_HEIGHT;
+    std::string dumpDirectory; // Empty: no frame dumps
+    int dumpInterval = 60;     // Dump every Nth frame
+    bool fullRedraw = false;   // Invalidate every layer each frame (raw rendering throughput)
+};
+
+// Renderer setup shared by the window and headless modes
+struct RenderOptions {
+    bool gpuTiming = false;   // Time each render pass on the GPU and draw the overlay
+    bool programCache = true; // Load linked shader programs saved by earlier runs
+    
+    // Threading: the simulation ticks at tickRate on its own thread and publishes a
+    // snapshot per tick; a render thread that owns the GL context draws the newest one
+    bool threaded = false;
+    int tickRate = 120;
+    
+    // Wall: more than one board tiles that many independent games into the window
+    int boards = 1;
+    
+    // Recording: every drawn frame is read back asynchronously and written to this Y4M video
+    std::string recordPath; // Empty: no recording
+    
+    // Dynamic resolution: scale the board layers to hold this frame time in ms (0 = native)
+    float frameBudget = 0.0f;
+    
+    // Texture uploads on a loader thread with a context sharing the game's objects
+    bool assetLoader = true;
+};
+
+// CPU time of a simulation tick and of a rendered frame, and the interval between
+// animation frames. On one thread a frame costs update plus render; with a render
+// thread the two overlap and the interval approaches the slower of them.
+void printFrameTimings(float updateMs, const GpuProfiler::RollingStats& renderTimes,
+                       const GpuProfiler::RollingStats& frameIntervals, bool threaded) {
+    std::cout << "Frame timings (" << (threaded ? "render thread" : "single thread") << "): update "
+              << updateMs << " ms, render " << renderTimes.getAverage() << " ms, frame interval "
+              << frameIntervals.getAverage() << " ms" << std::endl;
+}
+
+// Orthographic board camera shared by the window and headless modes
+glm::mat4 boardProjection(int width, int height) {
+    float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+    float orthoSize = 400.0f; // Adjust this to zoom in/out
+    return glm::ortho(-orthoSize * aspectRatio, orthoSize * aspectRatio,
+                      -orthoSize, orthoSize, -100.0f, 100.0f);
+}
+
 class MemoryCardGame {
 private:
     GLFWwindow* window;
     GameManager gameManager;
+    BoardWall wall;   // Used instead of gameManager with more than one board
+    bool wallMode;
+    int boardCount;
     Renderer renderer;
     std::unique_ptr<InputManager> inputManager;
     
@@ -28,12 +113,86 @@ private:
     std::chrono::high_resolution_clock::time_point lastFrameTime;
     float deltaTime;
     
-    // Camera matrices
+    // Edge detection for the face-mode toggles
+    bool proceduralKeyHeld;
+    bool indexedKeyHeld;
+    bool statsKeyHeld;
+    bool timingKeyHeld;
+    bool gpuTiming; // Start with GPU pass timing and its overlay on
+    int framesRendered;
+    
+    FramePacing pacing;
+    std::atomic<int> idleWakeups; // Ticks run after blocking for events
+    
+    // The simulation hands each tick to drawing as a snapshot. Single-threaded, every
+    // tick is drawn right away; threaded, the render thread owns the GL context and
+    // draws the newest snapshot while the next tick runs. The hand-off itself never
+    // locks: the mutex only guards the wakeup flag and GL work requested by input.
+    bool threaded;
+    int tickRate;
+    TripleBuffer<FrameSnapshot> snapshots;
+    BoardView view;
+    std::thread renderThread;
+    std::atomic<bool> rendering;
+    std::mutex renderMutex;
+    std::condition_variable renderWakeup;
+    bool renderWake;
+    std::vector<std::function<void()>> renderCommands;
+    
+    // Frame timings in ms: updates on the simulation side, the rest on the render side
+    GpuProfiler::RollingStats updateTimes;
+    std::atomic<float> updateMilliseconds; // Average of updateTimes, for the render side
+    GpuProfiler::RollingStats renderTimes;
+    GpuProfiler::RollingStats frameIntervals;
+    std::chrono::steady_clock::time_point lastFrameStart;
+    bool lastFrameAnimated;
+    
+    // Click-to-flip latency: from the input event to the GPU finishing the first frame of
+    // the flip. The simulation numbers each flip; the render side times the frame drawing it.
+    unsigned long long flipSerial;
+    std::chrono::steady_clock::time_point flipInputTime;
+    unsigned long long drawnFlipSerial;
+    bool latencyPending;
+    std::chrono::steady_clock::time_point latencyClickTime;
+    unsigned long long latencyFrame;
+    double latencyTotalMs;
+    int latencySamples;
+    
+    // Camera matrices; the projection here is the input side's, the render side derives
+    // its own from the renderer's viewport
     glm::mat4 viewMatrix;
     glm::mat4 projectionMatrix;
     
+    // Window size in screen coordinates (cursor positions) and in pixels (main thread)
+    int windowWidth;
+    int windowHeight;
+    int framebufferWidth;
+    int framebufferHeight;
+    float frameBudget;
+    
+    // Video capture of the window, stamped with the time since initialize (GL thread only)
+    FrameRecorder recorder;
+    std::string recordPath;
+    std::chrono::steady_clock::time_point recordStart;
+    
+    // Hidden window whose context the asset loader thread uploads through
+    GLFWwindow* loaderWindow;
+    bool assetLoader;
+    
 public:
-    MemoryCardGame() : window(nullptr), deltaTime(0.0f) {}
+    MemoryCardGame(const FramePacing& framePacing, const RenderOptions& renderOptions)
+        : window(nullptr), wallMode(renderOptions.boards > 1), boardCount(renderOptions.boards),
+          deltaTime(0.0f), proceduralKeyHeld(false), indexedKeyHeld(false),
+          statsKeyHeld(false), timingKeyHeld(false), gpuTiming(renderOptions.gpuTiming), framesRendered(0),
+          pacing(framePacing), idleWakeups(0), threaded(renderOptions.threaded),
+          tickRate(std::max(1, renderOptions.tickRate)), rendering(false), renderWake(false),
+          updateMilliseconds(0.0f), lastFrameAnimated(false), flipSerial(0), drawnFlipSerial(0),
+          latencyPending(false), latencyFrame(0), latencyTotalMs(0.0), latencySamples(0),
+          windowWidth(WINDOW_WIDTH), windowHeight(WINDOW_HEIGHT), framebufferWidth(WINDOW_WIDTH),
+          framebufferHeight(WINDOW_HEIGHT), frameBudget(renderOptions.frameBudget), recordPath(renderOptions.recordPath),
+          loaderWindow(nullptr), assetLoader(renderOptions.assetLoader) {
+        renderer.setProgramCacheEnabled(renderOptions.programCache);
+    }
     
     bool initialize() {
         // Initialize GLFW
@@ -46,7 +205,8 @@ public:
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-        glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+        // A recording keeps the size it started with, so the window stays fixed while recording
+        glfwWindowHint(GLFW_RESIZABLE, recordPath.empty() ? GL_TRUE : GL_FALSE);
         
         // Create window
         window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, nullptr, nullptr);
@@ -58,6 +218,10 @@ public:
         
         // Make OpenGL context current
         glfwMakeContextCurrent(window);
+        glfwSwapInterval(pacing.vsync ? 1 : 0);
+        
+        // A key tapped while the loop sleeps stays pressed until it is polled
+        glfwSetInputMode(window, GLFW_STICKY_KEYS, GLFW_TRUE);
         
         // Initialize renderer
         if (!renderer.initialize()) {
@@ -65,21 +229,66 @@ public:
             return false;
         }
         
-        // Set viewport dimensions for proper font scaling
-        renderer.setProjectionMatrix(WINDOW_WIDTH, WINDOW_HEIGHT);
+        // Set viewport dimensions for proper font scaling; on high-DPI screens the
+        // framebuffer has more pixels than the window has screen coordinates
+        glfwGetWindowSize(window, &windowWidth, &windowHeight);
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        renderer.setProjectionMatrix(framebufferWidth, framebufferHeight);
+        
+        // Dynamic resolution needs the GPU's cost to show as waiting for a frame slot
+        if (frameBudget > 0.0f && pacing.maxFramesInFlight == 0) {
+            pacing.maxFramesInFlight = 2;
+        }
+        renderer.setMaxFramesInFlight(pacing.maxFramesInFlight);
+        renderer.setFrameBudget(frameBudget);
+        renderer.setGpuProfiling(gpuTiming);
+        renderer.setGpuTimingOverlay(gpuTiming);
+        renderer.setLoadingOverlay(true);
+        
+        // GLFW shares objects between the contexts of windows created with a share
+        // window; the loader's is never shown and only made current on its thread
+        if (assetLoader) {
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            loaderWindow = glfwCreateWindow(1, 1, WINDOW_TITLE, nullptr, window);
+            glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+            GLFWwindow* shared = loaderWindow;
+            if (shared == nullptr) {
+                std::cerr << "Failed to create the asset loader context, uploading on the GL thread" << std::endl;
+            } else {
+                renderer.startAssetLoader([shared]() {
+                    glfwMakeContextCurrent(shared);
+                    return glfwGetCurrentContext() == shared;
+                }, []() {
+                    glfwMakeContextCurrent(nullptr);
+                });
+            }
+        }
+        
+        // The video runs at the animation rate, or 60 fps when uncapped
+        if (!recordPath.empty()) {
+            // The video keeps the size the window starts with
+            if (!recorder.start(recordPath, framebufferWidth, framebufferHeight, pacing.targetFps > 0 ? pacing.targetFps : 60)) {
+                return false;
+            }
+            recordStart = std::chrono::steady_clock::now();
+        }
         
         // Initialize input manager
         inputManager = std::make_unique<InputManager>(window);
         
         // Initialize game
-        gameManager.initialize(NUM_PAIRS);
+        if (wallMode) {
+            wall.initialize(boardCount, NUM_PAIRS, framebufferWidth, framebufferHeight);
+        } else {
+            gameManager.initialize(NUM_PAIRS);
+        }
         
         // Set up camera matrices
         setupCamera();
         
         // Set up OpenGL state
         glEnable(GL_DEPTH_TEST);
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        renderer.setBackgroundColor(glm::vec4(0.2f, 0.3f, 0.3f, 1.0f));
         
         // Initialize timing
         lastFrameTime = std::chrono::high_resolution_clock::now();
@@ -89,7 +298,27 @@ public:
         std::cout << "- Click on cards to flip them" << std::endl;
         std::cout << "- Match pairs to score points" << std::endl;
         std::cout << "- Press R to restart" << std::endl;
+        std::cout << "- Press P to toggle procedural card faces" << std::endl;
+        std::cout << "- Press I to toggle indexed (R8 + palette) card textures" << std::endl;
+        std::cout << "- Press G to print the last frame's GL call counts" << std::endl;
+        std::cout << "- Press T to toggle GPU pass timing and its overlay" << std::endl;
         std::cout << "- Press ESC to exit" << std::endl;
+        std::cout << "Frame pacing: " << (pacing.targetFps > 0 ? std::to_string(pacing.targetFps) + " fps" : "uncapped")
+                  << " while animating, vsync " << (pacing.vsync ? "on" : "off")
+                  << (pacing.idleWait ? ", waits for events when idle" : ", renders continuously") << std::endl;
+        std::cout << "Latency: " << (pacing.maxFramesInFlight > 0 ? std::to_string(pacing.maxFramesInFlight) : std::string("driver default"))
+                  << " frame(s) in flight, cards flip on mouse " << (pacing.flipOnPress ? "press" : "release") << std::endl;
+        if (wallMode) {
+            std::cout << "Board wall: " << boardCount << " games in " << wall.getColumns() << " x " << wall.getRows()
+                      << " tiles, one draw per layer" << std::endl;
+        }
+        if (frameBudget > 0.0f) {
+            std::cout << "Dynamic resolution: board layers scale down to " << ResolutionScaler::MIN_SCALE
+                      << " to hold " << frameBudget << " ms per frame, HUD at native resolution" << std::endl;
+        }
+        if (threaded) {
+            std::cout << "Threading: simulation at " << tickRate << " ticks/s, drawing on a render thread" << std::endl;
+        }
         
         return true;
     }
@@ -99,10 +328,32 @@ public:
         viewMatrix = glm::mat4(1.0f);
         
         // Set up projection matrix (orthographic for 2D)
-        float aspectRatio = static_cast<float>(WINDOW_WIDTH) / static_cast<float>(WINDOW_HEIGHT);
-        float orthoSize = 400.0f; // Adjust this to zoom in/out
-        projectionMatrix = glm::ortho(-orthoSize * aspectRatio, orthoSize * aspectRatio,
-                                    -orthoSize, orthoSize, -100.0f, 100.0f);
+        projectionMatrix = cameraProjection(framebufferWidth, framebufferHeight);
+    }
+    
+    glm::mat4 cameraProjection(int width, int height) const {
+        return wallMode ? wall.getProjection(width, height) : boardProjection(width, height);
+    }
+    
+    // Follow the window's size: input maps through the new projection right away, the
+    // renderer resizes its viewport and layers before its next frame
+    void handleResize() {
+        int width = 0, height = 0;
+        glfwGetFramebufferSize(window, &width, &height);
+        if (width <= 0 || height <= 0) {
+            return; // Minimized
+        }
+        glfwGetWindowSize(window, &windowWidth, &windowHeight);
+        if (width == framebufferWidth && height == framebufferHeight) {
+            return;
+        }
+        framebufferWidth = width;
+        framebufferHeight = height;
+        setupCamera();
+        runOnRenderThread([this, width, height] {
+            renderer.setProjectionMatrix(width, height);
+            std::cout << "Window resized to " << width << "x" << height << std::endl;
+        });
     }
     
     void updateDeltaTime() {
@@ -118,40 +369,210 @@ public:
     }
     
     void processInput() {
+        // Called right before update(), after any pacing or GPU wait, so input is fresh
         glfwPollEvents();
+        handleResize();
         inputManager->processInput(deltaTime);
         
-        // Handle mouse clicks
-        if (inputManager->isMouseReleased()) {
-            glm::vec2 screenPos = inputManager->getMousePosition();
-            glm::vec2 worldPos = inputManager->screenToWorld(screenPos, WINDOW_WIDTH, WINDOW_HEIGHT);
-            gameManager.handleMouseClick(worldPos.x, worldPos.y);
+        // Hovering starts face generation for nearby cards; clicks flip them
+        glm::vec2 screenPos = inputManager->getMousePosition();
+        if (screenPos != inputManager->getLastMousePosition()) {
+            if (wallMode) {
+                glm::vec2 wallPos = wall.screenToWall(screenPos, windowWidth, windowHeight);
+                wall.handleMouseMove(wallPos.x, wallPos.y);
+            } else {
+                glm::vec2 worldPos = InputManager::screenToWorld(screenPos, projectionMatrix, windowWidth, windowHeight);
+                gameManager.handleMouseMove(worldPos.x, worldPos.y);
+            }
+        }
+        bool clicked = pacing.flipOnPress ? inputManager->isMouseJustPressed() : inputManager->isMouseReleased();
+        if (clicked && handleClick(screenPos)) {
+            // The flip shows in the first frame that draws this tick's snapshot
+            flipSerial++;
+            flipInputTime = pacing.flipOnPress ? inputManager->getPressTime() : inputManager->getReleaseTime();
         }
         
         // Handle reset key
         if (inputManager->isKeyPressed(GLFW_KEY_R)) {
-            gameManager.reset(NUM_PAIRS);
+            if (wallMode) {
+                wall.reset();
+            } else {
+                gameManager.reset(NUM_PAIRS);
+            }
             std::cout << "Game reset!" << std::endl;
         }
+        
+        // Toggle between shader-drawn faces and the CPU-generated atlas for comparison
+        bool proceduralKeyDown = inputManager->isKeyPressed(GLFW_KEY_P);
+        if (proceduralKeyDown && !proceduralKeyHeld) {
+            runOnRenderThread([this] {
+                renderer.setProceduralFaces(!renderer.getProceduralFaces());
+                std::cout << "Card faces: " << (renderer.getProceduralFaces() ? "procedural shader" : "texture atlas") << std::endl;
+            });
+        }
+        proceduralKeyHeld = proceduralKeyDown;
+        
+        // Toggle between the palette-indexed and full RGBA atlas; the board rebuilds it on the next frame
+        bool indexedKeyDown = inputManager->isKeyPressed(GLFW_KEY_I);
+        if (indexedKeyDown && !indexedKeyHeld) {
+            runOnRenderThread([this] {
+                renderer.setIndexedFaces(!renderer.getIndexedFaces());
+                std::cout << "Card textures: " << (renderer.getIndexedFaces() ? "indexed R8 + palette" : "RGBA8") << std::endl;
+            });
+        }
+        indexedKeyHeld = indexedKeyDown;
+        
+        // Report per-frame GL work (also printed once after the first full frame)
+        bool statsKeyDown = inputManager->isKeyPressed(GLFW_KEY_G);
+        if (statsKeyDown && !statsKeyHeld) {
+            runOnRenderThread([this] { printStats(); });
+        }
+        statsKeyHeld = statsKeyDown;
+        
+        // GPU time per pass, shown top right; turning it off deletes the queries
+        bool timingKeyDown = inputManager->isKeyPressed(GLFW_KEY_T);
+        if (timingKeyDown && !timingKeyHeld) {
+            gpuTiming = !gpuTiming;
+            bool enabled = gpuTiming;
+            runOnRenderThread([this, enabled] {
+                renderer.setGpuProfiling(enabled);
+                renderer.setGpuTimingOverlay(enabled);
+                std::cout << "GPU pass timing: " << (enabled ? "on" : "off") << std::endl;
+            });
+        }
+        timingKeyHeld = timingKeyDown;
+    }
+    
+    bool handleClick(glm::vec2 screenPos) {
+        if (wallMode) {
+            glm::vec2 wallPos = wall.screenToWall(screenPos, windowWidth, windowHeight);
+            return wall.handleMouseClick(wallPos.x, wallPos.y);
+        }
+        glm::vec2 worldPos = InputManager::screenToWorld(screenPos, projectionMatrix, windowWidth, windowHeight);
+        return gameManager.handleMouseClick(worldPos.x, worldPos.y);
+    }
+    
+    // Also while card faces stream in, so the loader is polled and the progress shown
+    bool needsContinuousFrames() const {
+        return (wallMode ? wall.needsContinuousFrames() : gameManager.needsContinuousFrames()) ||
+               renderer.isLoadingAssets();
     }
     
     void update() {
-        gameManager.update(deltaTime);
+        auto updateStart = std::chrono::steady_clock::now();
+        if (wallMode) {
+            wall.update(deltaTime);
+        } else {
+            gameManager.update(deltaTime);
+        }
         inputManager->update();
+        
+        // Hand the tick to the render side. The wall is never threaded and draws its
+        // boards directly, so its snapshot only carries the frame's timing fields.
+        FrameSnapshot& snapshot = snapshots.writeBuffer();
+        if (wallMode) {
+            snapshot.continuousFrames = wall.needsContinuousFrames();
+        } else {
+            gameManager.publish(snapshot);
+        }
+        snapshot.continuousFrames = snapshot.continuousFrames || renderer.isLoadingAssets();
+        snapshot.flipSerial = flipSerial;
+        snapshot.flipInputTime = flipInputTime;
+        snapshots.publish();
+        
+        updateTimes.add(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - updateStart).count());
+        updateMilliseconds = updateTimes.getAverage();
+        if (threaded) {
+            wakeRenderThread();
+        }
     }
     
-    void render() {
+    // GL thread only
+    void render(const FrameSnapshot& snapshot) {
+        auto frameStart = std::chrono::steady_clock::now();
+        if (lastFrameAnimated) {
+            frameIntervals.add(std::chrono::duration<float, std::milli>(frameStart - lastFrameStart).count());
+        }
+        lastFrameStart = frameStart;
+        lastFrameAnimated = snapshot.continuousFrames;
+        
         // Clear the screen
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
-        // Render the game
-        gameManager.render(renderer.getCardShaderProgram(), viewMatrix, projectionMatrix, &renderer);
+        // Upload the camera once, then draw the snapshot; only the layers that changed are
+        // redrawn, and endFrame composites the cached layers to the window
+        int width = static_cast<int>(renderer.getViewportWidth());
+        int height = static_cast<int>(renderer.getViewportHeight());
+        renderer.beginFrame(viewMatrix, cameraProjection(width, height));
+        if (wallMode) {
+            wall.render(&renderer, width, height);
+        } else {
+            view.render(snapshot, &renderer);
+        }
+        renderer.endFrame();
+        
+        // The first frame showing a new flip is the one its latency waits for
+        if (snapshot.flipSerial != drawnFlipSerial) {
+            drawnFlipSerial = snapshot.flipSerial;
+            latencyPending = true;
+            latencyClickTime = snapshot.flipInputTime;
+            latencyFrame = renderer.getFrameNumber();
+        }
         
-        // Render UI elements
-        renderUI();
+        // Queue the readback of the finished back buffer before it is swapped away
+        recorder.capture(0, std::chrono::duration<double>(frameStart - recordStart).count());
+        renderTimes.add(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
         
         // Swap buffers
         glfwSwapBuffers(window);
+        framesRendered++;
+        if (framesRendered == 2) {
+            printStats();
+        }
+    }
+    
+    // GL thread only
+    void printStats() {
+        renderer.printFrameStats();
+        std::cout << "Frames rendered: " << framesRendered << " (" << idleWakeups << " after idle waits)" << std::endl;
+        printFrameTimings(updateMilliseconds, renderTimes, frameIntervals, threaded);
+        if (renderer.getGpuProfiling()) {
+            renderer.printGpuTimings();
+        }
+    }
+    
+    // Run GL work for input: right away on one thread, else before the render thread's next frame
+    void runOnRenderThread(std::function<void()> command) {
+        if (!threaded) {
+            command();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(renderMutex);
+            renderCommands.push_back(std::move(command));
+            renderWake = true;
+        }
+        renderWakeup.notify_one();
+    }
+    
+    void wakeRenderThread() {
+        {
+            std::lock_guard<std::mutex> lock(renderMutex);
+            renderWake = true;
+        }
+        renderWakeup.notify_one();
+    }
+    
+    bool runRenderCommands() {
+        std::vector<std::function<void()>> commands;
+        {
+            std::lock_guard<std::mutex> lock(renderMutex);
+            commands.swap(renderCommands);
+        }
+        for (auto& command : commands) {
+            command();
+        }
+        return !commands.empty();
     }
     
     void renderUI() {
@@ -163,6 +584,15 @@ public:
         static int lastMoves = -1;
         static int lastTime = -1;
         
+        if (wallMode) {
+            int won = wall.getBoardsWon();
+            if (won != lastScore) {
+                lastScore = won;
+                std::cout << "Boards won: " << won << " of " << wall.getBoardCount() << std::endl;
+            }
+            return;
+        }
+        
         int currentScore = gameManager.getScore();
         int currentMoves = gameManager.getMoves();
         int currentTime = static_cast<int>(gameManager.getElapsedTime());
@@ -185,16 +615,126 @@ public:
     }
     
     void run() {
+        if (threaded) {
+            runThreaded();
+            return;
+        }
+        
+        bool waited = false;
         while (!glfwWindowShouldClose(window)) {
+            auto frameStart = std::chrono::steady_clock::now();
+            
+            // Bound the frames in flight before sampling input, so waiting on the GPU
+            // never ages the input this frame acts on
+            renderer.waitForFrameSlot();
+            reportClickLatency();
             updateDeltaTime();
             processInput();
             update();
-            render();
+            snapshots.acquire();
+            render(snapshots.readBuffer());
+            renderUI();
+            if (waited) {
+                idleWakeups++;
+            }
+            waited = pace(frameStart, pacing.targetFps);
         }
     }
     
+    // GLFW delivers events on the main thread only, so the simulation stays here and
+    // the render thread takes the context
+    void runThreaded() {
+        glfwMakeContextCurrent(nullptr);
+        rendering = true;
+        renderThread = std::thread(&MemoryCardGame::renderLoop, this);
+        
+        bool waited = false;
+        while (!glfwWindowShouldClose(window)) {
+            auto tickStart = std::chrono::steady_clock::now();
+            updateDeltaTime();
+            processInput();
+            update();
+            renderUI();
+            if (waited) {
+                idleWakeups++;
+            }
+            waited = pace(tickStart, tickRate);
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(renderMutex);
+            rendering = false;
+        }
+        renderWakeup.notify_one();
+        renderThread.join();
+        glfwMakeContextCurrent(window); // Cleanup deletes GL objects
+    }
+    
+    void renderLoop() {
+        glfwMakeContextCurrent(window);
+        while (rendering) {
+            auto frameStart = std::chrono::steady_clock::now();
+            renderer.waitForFrameSlot();
+            reportClickLatency();
+            bool commanded = runRenderCommands();
+            
+            // Draw when a newer tick is out (or input changed how frames look);
+            // otherwise sleep until the simulation publishes
+            bool fresh = snapshots.acquire();
+            if (!fresh && !(commanded && framesRendered > 0)) {
+                std::unique_lock<std::mutex> lock(renderMutex);
+                renderWakeup.wait(lock, [this] { return renderWake || !rendering; });
+                renderWake = false;
+                continue;
+            }
+            render(snapshots.readBuffer());
+            
+            // Ticks may outpace the display: hold the target rate (vsync already blocks in the swap)
+            if (pacing.targetFps > 0) {
+                std::this_thread::sleep_until(frameStart + std::chrono::microseconds(1000000 / pacing.targetFps));
+            }
+        }
+        glfwMakeContextCurrent(nullptr);
+    }
+    
+    void reportClickLatency() {
+        if (!latencyPending || renderer.getCompletedFrame() < latencyFrame) {
+            return;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - latencyClickTime).count();
+        latencyPending = false;
+        latencyTotalMs += ms;
+        latencySamples++;
+        std::cout << "Click-to-flip latency: " << ms << " ms (average " << latencyTotalMs / latencySamples
+                  << " ms over " << latencySamples << " flips)" << std::endl;
+    }
+    
+    // Wait before the next frame (or tick); returns true if the loop blocked for events
+    bool pace(std::chrono::steady_clock::time_point frameStart, int rate) {
+        if (pacing.idleWait && !needsContinuousFrames()) {
+            // Nothing moves: sleep until input, or until the clock shows a new second
+            float untilTick = wallMode ? wall.getSecondsUntilClockTick() : gameManager.getSecondsUntilClockTick();
+            glfwWaitEventsTimeout(untilTick + 0.001);
+            
+            // Time spent waiting is not animation time
+            lastFrameTime = std::chrono::high_resolution_clock::now();
+            return true;
+        }
+        
+        // Animating: hold the target rate (vsync already blocks in glfwSwapBuffers)
+        if (rate > 0) {
+            std::this_thread::sleep_until(frameStart + std::chrono::microseconds(1000000 / rate));
+        }
+        return false;
+    }
+    
     void cleanup() {
-        renderer.cleanup();
+        recorder.finish(); // Still needs the context for its last readbacks
+        renderer.cleanup(); // Ends the loader thread before its context goes
+        if (loaderWindow) {
+            glfwDestroyWindow(loaderWindow);
+            loaderWindow = nullptr;
+        }
         if (window) {
             glfwDestroyWindow(window);
         }
@@ -206,8 +746,266 @@ public:
     }
 };
 
-int main() {
-    MemoryCardGame game;
+int runHeadless(const HeadlessOptions& options, const RenderOptions& renderOptions) {
+    HeadlessContext context;
+    if (!context.create(options.width, options.height)) {
+        return -1;
+    }
+    
+    // The same Renderer and GameManager as the windowed game, drawing into the context's framebuffer
+    int result = 0;
+    {
+        Renderer renderer;
+        GameManager gameManager;
+        BoardWall wall;
+        bool wallMode = renderOptions.boards > 1;
+        renderer.setProgramCacheEnabled(renderOptions.programCache);
+        if (!renderer.initialize()) {
+            std::cerr << "Failed to initialize renderer" << std::endl;
+            return -1;
+        }
+        renderer.setTargetFramebuffer(context.getFramebuffer());
+        renderer.setProjectionMatrix(options.width, options.height);
+        renderer.setBackgroundColor(glm::vec4(0.2f, 0.3f, 0.3f, 1.0f));
+        renderer.setGpuProfiling(renderOptions.gpuTiming);
+        renderer.setGpuTimingOverlay(renderOptions.gpuTiming);
+        renderer.setLoadingOverlay(true);
+        if (renderOptions.assetLoader && context.createSharedContext()) {
+            renderer.startAssetLoader([&context]() { return context.makeSharedContextCurrent(); },
+                                      [&context]() { context.releaseSharedContext(); });
+        }
+        renderer.setFrameBudget(renderOptions.frameBudget);
+        if (renderOptions.frameBudget > 0.0f) {
+            renderer.setMaxFramesInFlight(2); // As in the window: GPU cost shows as slot waits
+        }
+        glEnable(GL_DEPTH_TEST);
+        if (wallMode) {
+            wall.initialize(renderOptions.boards, NUM_PAIRS, options.width, options.height);
+        } else {
+            gameManager.initialize(NUM_PAIRS);
+        }
+        glm::mat4 viewMatrix(1.0f);
+        glm::mat4 projectionMatrix = wallMode ? wall.getProjection(options.width, options.height)
+                                              : boardProjection(options.width, options.height);
+        FrameRecorder recorder;
+        if (!renderOptions.recordPath.empty() &&
+            !recorder.start(renderOptions.recordPath, options.width, options.height, 60)) {
+            renderer.cleanup();
+            return -1;
+        }
+        
+        // Scripted play: click the cards in deal order, one every CLICK_SECONDS (clicks
+        // during animations are ignored by the click guard). Single-threaded, every frame
+        // runs one tick of a fixed 60 Hz step; threaded, the simulation thread ticks at
+        // the tick rate in real time while this thread draws the newest snapshot. On a
+        // wall every board plays the same script, each a few ticks after the previous one.
+        const float CLICK_SECONDS = 1.0f / 3.0f;
+        const int WALL_CLICK_STAGGER = 7;
+        int tickRate = renderOptions.threaded ? std::max(1, renderOptions.tickRate) : 60;
+        unsigned long long clickInterval = std::max(1, static_cast<int>(tickRate * CLICK_SECONDS + 0.5f));
+        std::vector<size_t> nextCards(wallMode ? wall.getBoardCount() : 1, 0);
+        auto click = [&](GameManager& game, size_t& nextCard) {
+            const auto& cards = game.getDeck().getCards();
+            if (!cards.empty()) {
+                glm::vec2 position = cards[nextCard % cards.size()]->getPosition();
+                game.handleMouseClick(position.x, position.y);
+                nextCard++;
+            }
+        };
+        auto tick = [&](unsigned long long tickNumber) {
+            if (!wallMode) {
+                if (tickNumber % clickInterval == 0) {
+                    click(gameManager, nextCards[0]);
+                }
+                gameManager.update(1.0f / tickRate);
+                return;
+            }
+            for (int board = 0; board < wall.getBoardCount(); board++) {
+                if ((tickNumber + board * WALL_CLICK_STAGGER) % clickInterval == 0) {
+                    click(wall.getBoard(board), nextCards[board]);
+                }
+            }
+            wall.update(1.0f / tickRate);
+        };
+        
+        GpuProfiler::RollingStats updateTimes;
+        GpuProfiler::RollingStats renderTimes;
+        GpuProfiler::RollingStats frameIntervals;
+        std::atomic<float> updateMilliseconds(0.0f);
+        auto timeTick = [&](unsigned long long tickNumber) {
+            auto tickStart = std::chrono::steady_clock::now();
+            tick(tickNumber);
+            updateTimes.add(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tickStart).count());
+            updateMilliseconds = updateTimes.getAverage();
+        };
+        
+        TripleBuffer<FrameSnapshot> snapshots;
+        BoardView view;
+        std::atomic<bool> simulating(true);
+        std::atomic<unsigned long long> ticks(0);
+        std::thread simulation;
+        if (renderOptions.threaded) {
+            simulation = std::thread([&] {
+                auto nextTick = std::chrono::steady_clock::now();
+                while (simulating) {
+                    timeTick(ticks);
+                    gameManager.publish(snapshots.writeBuffer());
+                    snapshots.publish();
+                    ticks++;
+                    nextTick += std::chrono::microseconds(1000000 / tickRate);
+                    std::this_thread::sleep_until(nextTick);
+                }
+            });
+            while (!snapshots.acquire()) {
+                std::this_thread::yield();
+            }
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        auto lastFrameStart = start;
+        for (int frame = 0; frame < options.frames; frame++) {
+            auto frameStart = std::chrono::steady_clock::now();
+            if (frame > 0) {
+                frameIntervals.add(std::chrono::duration<float, std::milli>(frameStart - lastFrameStart).count());
+            }
+            lastFrameStart = frameStart;
+            renderer.waitForFrameSlot();
+            if (!renderOptions.threaded) {
+                timeTick(ticks++);
+            }
+            if (options.fullRedraw) {
+                renderer.markAllLayersDirty();
+            }
+            
+            auto renderStart = std::chrono::steady_clock::now();
+            glBindFramebuffer(GL_FRAMEBUFFER, context.getFramebuffer());
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            renderer.beginFrame(viewMatrix, projectionMatrix);
+            if (renderOptions.threaded) {
+                snapshots.acquire(); // Keeps the last snapshot when no tick finished since
+                view.render(snapshots.readBuffer(), &renderer);
+            } else if (wallMode) {
+                wall.render(&renderer, options.width, options.height);
+            } else {
+                gameManager.render(&renderer);
+            }
+            renderer.endFrame();
+            
+            // Single-threaded frames are 60 Hz steps of game time; threaded ones are shown in real time
+            recorder.capture(context.getFramebuffer(), renderOptions.threaded
+                                 ? std::chrono::duration<double>(frameStart - start).count()
+                                 : frame / 60.0);
+            renderTimes.add(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - renderStart).count());
+            
+            if (!options.dumpDirectory.empty() && frame % options.dumpInterval == 0) {
+                char name[32];
+                std::snprintf(name, sizeof(name), "/frame_%05d.ppm", frame);
+                if (!context.saveFrame(options.dumpDirectory + name)) {
+                    result = -1;
+                    break;
+                }
+            }
+        }
+        recorder.finish();
+        glFinish();
+        simulating = false;
+        if (simulation.joinable()) {
+            simulation.join();
+        }
+        
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Headless: " << options.frames << " frames in " << seconds * 1000.0 << " ms ("
+                  << options.frames / seconds << " fps, " << seconds * 1000.0 / options.frames << " ms/frame"
+                  << (options.fullRedraw ? ", full redraw" : ", retained layers") << ")" << std::endl;
+        if (wallMode) {
+            std::cout << "Board wall: " << wall.getBoardCount() << " games in " << wall.getColumns() << " x "
+                      << wall.getRows() << " tiles, " << wall.getBoardsWon() << " won" << std::endl;
+        }
+        if (renderOptions.threaded) {
+            std::cout << "Simulation: " << ticks << " ticks at " << tickRate << " ticks/s on its own thread" << std::endl;
+        }
+        printFrameTimings(updateMilliseconds, renderTimes, frameIntervals, renderOptions.threaded);
+        renderer.printFrameStats();
+        if (renderOptions.gpuTiming) {
+            renderer.printGpuTimings();
+        }
+        renderer.cleanup(); // Needs the context, which is destroyed below
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    FramePacing pacing;
+    HeadlessOptions headless;
+    RenderOptions renderOptions;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--fps" && i + 1 < argc) {
+            pacing.targetFps = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--no-vsync") {
+            pacing.vsync = false;
+        } else if (arg == "--continuous") {
+            pacing.idleWait = false;
+        } else if (arg == "--frames-in-flight" && i + 1 < argc) {
+            pacing.maxFramesInFlight = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--flip-on-press") {
+            pacing.flipOnPress = true;
+        } else if (arg == "--low-latency") {
+            pacing.maxFramesInFlight = 1;
+            pacing.flipOnPress = true;
+        } else if (arg == "--headless") {
+            headless.enabled = true;
+        } else if (arg == "--frames" && i + 1 < argc) {
+            headless.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--size" && i + 2 < argc) {
+            headless.width = std::max(1, std::atoi(argv[++i]));
+            headless.height = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--dump" && i + 1 < argc) {
+            headless.dumpDirectory = argv[++i];
+        } else if (arg == "--dump-interval" && i + 1 < argc) {
+            headless.dumpInterval = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--full-redraw") {
+            headless.fullRedraw = true;
+        } else if (arg == "--gpu-timing") {
+            renderOptions.gpuTiming = true;
+        } else if (arg == "--no-program-cache") {
+            renderOptions.programCache = false;
+        } else if (arg == "--threaded") {
+            renderOptions.threaded = true;
+        } else if (arg == "--tick-rate" && i + 1 < argc) {
+            renderOptions.tickRate = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--boards" && i + 1 < argc) {
+            renderOptions.boards = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--record" && i + 1 < argc) {
+            renderOptions.recordPath = argv[++i];
+        } else if (arg == "--frame-budget" && i + 1 < argc) {
+            renderOptions.frameBudget = std::max(0.0f, static_cast<float>(std::atof(argv[++i])));
+        } else if (arg == "--no-asset-loader") {
+            renderOptions.assetLoader = false;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--fps N] [--no-vsync] [--continuous]"
+                      << " [--frames-in-flight N] [--flip-on-press] [--low-latency] [--gpu-timing]"
+                      << " [--no-program-cache] [--threaded] [--tick-rate N]"
+                      << " [--boards N] [--record FILE.y4m] [--frame-budget MS] [--no-asset-loader]" << std::endl;
+            std::cerr << "       " << argv[0] << " --headless [--frames N] [--size W H] [--dump DIR]"
+                      << " [--dump-interval N] [--full-redraw] [--gpu-timing]"
+                      << " [--no-program-cache] [--threaded] [--tick-rate N] [--boards N]"
+                      << " [--record FILE.y4m] [--frame-budget MS] [--no-asset-loader]" << std::endl;
+            return -1;
+        }
+    }
+    
+    // The wall draws its boards directly on one thread
+    if (renderOptions.boards > 1 && renderOptions.threaded) {
+        std::cerr << "--threaded draws a single board; ignored with --boards" << std::endl;
+        renderOptions.threaded = false;
+    }
+    
+    if (headless.enabled) {
+        return runHeadless(headless, renderOptions);
+    }
+    
+    MemoryCardGame game(pacing, renderOptions);
     
     if (!game.initialize()) {
         std::cerr << "Failed to initialize game" << std::endl;